@@ -0,0 +1,279 @@
+//
+// Created by yunarta on 10/18/26.
+//
+// Local MQTT broker stand-in for the host tests. It accepts TCP connections on 127.0.0.1 and
+// finishes the modelled TLS handshake by sending one byte after a delay, or never when stalled.
+// After that it speaks just enough MQTT 3.1.1 for PubSubClient: CONNACK, SUBACK, PUBACK and
+// PINGRESP, records what the device publishes and delivers QoS1 messages to it.
+//
+
+#ifndef HOST_BROKERSTANDIN_H
+#define HOST_BROKERSTANDIN_H
+
+#include <Arduino.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static const char *LOCALHOST = "127.0.0.1";
+
+struct BrokerMessage {
+    String topic;
+    String payload;
+};
+
+class BrokerStandIn {
+    struct Connection {
+        int socket;
+        unsigned long handshakeAt;
+        bool greeted;
+        bool session;
+        std::vector<uint8_t> received;
+    };
+
+    int listener = -1;
+    uint16_t port = 0;
+    uint16_t packetId = 0;
+    std::atomic<unsigned long> handshakeDelayMs;
+    std::atomic<bool> stalled;
+    std::atomic<bool> refusing;
+    std::atomic<bool> running;
+    std::atomic<unsigned long> accepted;
+    std::atomic<unsigned long> sessions;
+    std::mutex lock;
+    std::vector<Connection> connections;
+    std::vector<BrokerMessage> published;
+    std::thread worker;
+
+    static void sendPacket(int socket, uint8_t type, const std::vector<uint8_t> &body) {
+        std::vector<uint8_t> packet{type};
+        size_t length = body.size();
+        do {
+            uint8_t digit = length % 128;
+            length /= 128;
+            packet.push_back(length > 0 ? digit | 0x80 : digit);
+        } while (length > 0);
+        packet.insert(packet.end(), body.begin(), body.end());
+        send(socket, packet.data(), packet.size(), MSG_NOSIGNAL);
+    }
+
+    static String readString(const uint8_t *data, size_t &offset) {
+        size_t length = (data[offset] << 8) | data[offset + 1];
+        String value(reinterpret_cast<const char *>(data + offset + 2), length);
+        offset += 2 + length;
+        return value;
+    }
+
+    void handlePacket(Connection &connection, uint8_t type, const uint8_t *body, size_t length) {
+        switch (type & 0xF0) {
+            case 0x10: // CONNECT
+                if (refusing) {
+                    // not authorized, the handshake worked but the MQTT connect fails
+                    sendPacket(connection.socket, 0x20, {0x00, 0x05});
+                    break;
+                }
+                connection.session = true;
+                sessions++;
+                sendPacket(connection.socket, 0x20, {0x00, 0x00});
+                break;
+            case 0x30: { // PUBLISH
+                size_t offset = 0;
+                BrokerMessage message;
+                message.topic = readString(body, offset);
+                if ((type & 0x06) != 0) {
+                    sendPacket(connection.socket, 0x40, {body[offset], body[offset + 1]});
+                    offset += 2;
+                }
+                message.payload = String(reinterpret_cast<const char *>(body + offset), length - offset);
+                published.push_back(message);
+                break;
+            }
+            case 0x80: { // SUBSCRIBE, every filter is granted QoS1
+                std::vector<uint8_t> reply{body[0], body[1]};
+                for (size_t offset = 2; offset < length; offset++) {
+                    readString(body, offset);
+                    reply.push_back(0x01);
+                }
+                sendPacket(connection.socket, 0x90, reply);
+                break;
+            }
+            case 0xC0: // PINGREQ
+                sendPacket(connection.socket, 0xD0, {});
+                break;
+            default:
+                break;
+        }
+    }
+
+    void receive(Connection &connection) {
+        uint8_t buffer[1024];
+        ssize_t count;
+        while ((count = recv(connection.socket, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+            connection.received.insert(connection.received.end(), buffer, buffer + count);
+        }
+
+        std::vector<uint8_t> &data = connection.received;
+        while (data.size() >= 2) {
+            size_t length = 0;
+            size_t offset = 1;
+            uint32_t multiplier = 1;
+            do {
+                if (offset >= data.size()) {
+                    return;
+                }
+                length += (data[offset] & 0x7F) * multiplier;
+                multiplier *= 128;
+            } while ((data[offset++] & 0x80) != 0);
+
+            if (data.size() < offset + length) {
+                return;
+            }
+            handlePacket(connection, data[0], data.data() + offset, length);
+            data.erase(data.begin(), data.begin() + offset + length);
+        }
+    }
+
+    void serve() {
+        while (running) {
+            pollfd descriptor{.fd = listener, .events = POLLIN, .revents = 0};
+            if (poll(&descriptor, 1, 5) > 0) {
+                int socket = accept(listener, nullptr, nullptr);
+                if (socket >= 0) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    connections.push_back({socket, millis() + handshakeDelayMs, false, false, {}});
+                    accepted++;
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            for (Connection &connection: connections) {
+                if (!connection.greeted) {
+                    if (!stalled && millis() >= connection.handshakeAt) {
+                        uint8_t greeting = 0x20;
+                        send(connection.socket, &greeting, 1, MSG_NOSIGNAL);
+                        connection.greeted = true;
+                    }
+                } else {
+                    receive(connection);
+                }
+            }
+        }
+    }
+
+public:
+    explicit BrokerStandIn(unsigned long handshakeDelayMs, bool stalled = false): handshakeDelayMs(handshakeDelayMs),
+                                                                                 stalled(stalled),
+                                                                                 refusing(false),
+                                                                                 running(false),
+                                                                                 accepted(0),
+                                                                                 sessions(0) {
+    }
+
+    ~BrokerStandIn() {
+        stop();
+    }
+
+    bool start(uint16_t requestedPort = 0) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(requestedPort);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (bind(listener, reinterpret_cast<sockaddr *>(&address), length) != 0
+            || listen(listener, 8) != 0
+            || getsockname(listener, reinterpret_cast<sockaddr *>(&address), &length) != 0) {
+            close(listener);
+            listener = -1;
+            return false;
+        }
+
+        port = ntohs(address.sin_port);
+        running = true;
+        worker = std::thread(&BrokerStandIn::serve, this);
+        return true;
+    }
+
+    // broker outage: the port refuses connections and every session is dropped
+    void stop() {
+        running = false;
+        if (worker.joinable()) {
+            worker.join();
+        }
+        if (listener >= 0) {
+            close(listener);
+            listener = -1;
+        }
+        dropConnections();
+    }
+
+    void dropConnections() {
+        std::lock_guard<std::mutex> guard(lock);
+        for (Connection &connection: connections) {
+            close(connection.socket);
+        }
+        connections.clear();
+    }
+
+    // answer CONNECT with "not authorized" while set
+    void refuseSessions(bool refuse) {
+        refusing = refuse;
+    }
+
+    // QoS1 PUBLISH to every MQTT session, dup marks a redelivery
+    void deliver(const String &topic, const String &payload, bool dup = false) {
+        std::lock_guard<std::mutex> guard(lock);
+        packetId++;
+        std::vector<uint8_t> body{static_cast<uint8_t>(topic.length() >> 8), static_cast<uint8_t>(topic.length())};
+        body.insert(body.end(), topic.c_str(), topic.c_str() + topic.length());
+        body.push_back(packetId >> 8);
+        body.push_back(packetId & 0xFF);
+        body.insert(body.end(), payload.c_str(), payload.c_str() + payload.length());
+        for (Connection &connection: connections) {
+            if (connection.session) {
+                sendPacket(connection.socket, dup ? 0x3A : 0x32, body);
+            }
+        }
+    }
+
+    // messages published by the device on topic
+    std::vector<BrokerMessage> getPublished(const String &topic) {
+        std::lock_guard<std::mutex> guard(lock);
+        std::vector<BrokerMessage> messages;
+        for (const BrokerMessage &message: published) {
+            if (message.topic.equals(topic)) {
+                messages.push_back(message);
+            }
+        }
+        return messages;
+    }
+
+    uint16_t getPort() {
+        return port;
+    }
+
+    String getKey() {
+        return String(LOCALHOST) + ":" + port;
+    }
+
+    unsigned long getAccepted() {
+        return accepted;
+    }
+
+    // MQTT sessions, connections that got past the handshake and sent CONNECT
+    unsigned long getSessions() {
+        return sessions;
+    }
+};
+
+#endif //HOST_BROKERSTANDIN_H
@@ -0,0 +1,192 @@
+//
+// Created by yunarta on 10/18/26.
+//
+// Runs command dedupe and the command executor end to end: commands and their QoS1
+// redeliveries come from a local broker stand-in, replies are read back from what the
+// device published on the command response topics.
+//
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <aws_utils.h>
+
+#include <atomic>
+
+#include "BrokerStandIn.h"
+#include "IdentityShadowThing.h"
+
+static int failures = 0;
+
+#define CHECK(condition)                                                     \
+    do {                                                                     \
+        if (!(condition)) {                                                  \
+            fprintf(stderr, "[FAIL] %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                      \
+        }                                                                    \
+    } while (0)
+
+static String commandTopic(const String &executionId, const char *suffix) {
+    return "$aws/commands/things/" + thingNameWithMac(ESP.getChipModel()) + "/executions/" + executionId + suffix;
+}
+
+static void deliverCommand(BrokerStandIn &broker, const String &executionId, bool dup = false) {
+    broker.deliver(commandTopic(executionId, "/request/json"), "{\"command\":\"reboot\"}", dup);
+}
+
+static std::vector<BrokerMessage> responses(BrokerStandIn &broker, const String &executionId) {
+    return broker.getPublished(commandTopic(executionId, "/response/json"));
+}
+
+static bool hasStatus(const BrokerMessage &message, const char *status) {
+    JsonDocument doc;
+    return !deserializeJson(doc, message.payload.c_str()) && doc["status"].as<String>().equals(status);
+}
+
+// loops for durationMs, long enough for deliveries and replies to make the round trip
+static void loopFor(IdentityShadowThing &thing, unsigned long durationMs) {
+    unsigned long start = millis();
+    while (millis() - start < durationMs) {
+        thing.loop();
+        delay(5);
+    }
+}
+
+static bool connect(IdentityShadowThing &thing, BrokerStandIn &broker) {
+    Preferences::hostReset();
+    Preferences preferences;
+    preferences.begin("aws-iot", false);
+    preferences.putBool("provisioned", true);
+    preferences.end();
+
+    thing.addEndpoint(LOCALHOST, broker.getPort());
+    thing.begin();
+    for (int i = 0; i < 20 && thing.getConnectionState() != CONNECTED; i++) {
+        thing.loop();
+    }
+    loopFor(thing, 100);
+    return thing.getConnectionState() == CONNECTED;
+}
+
+static void testRedeliveryWithoutExecutor() {
+    BrokerStandIn broker(0);
+    CHECK(broker.start());
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    int syncCalls = 0;
+    int deferredCalls = 0;
+    thing.setCommandCallback([&](const String &executionId, JsonDocument &payload) -> bool {
+        if (executionId.equals("sync")) {
+            syncCalls++;
+            CommandReply reply{
+                .status = "SUCCEEDED",
+            };
+            thing.commandReply(executionId, reply);
+        } else {
+            // replies later, from outside the callback
+            deferredCalls++;
+        }
+        return true;
+    });
+    CHECK(connect(thing, broker));
+
+    // a redelivery of a replied command gets the cached reply instead of running again
+    deliverCommand(broker, "sync");
+    loopFor(thing, 100);
+    deliverCommand(broker, "sync", true);
+    loopFor(thing, 100);
+    CHECK(syncCalls == 1);
+    std::vector<BrokerMessage> replies = responses(broker, "sync");
+    CHECK(replies.size() == 2);
+    for (const BrokerMessage &reply: replies) {
+        CHECK(hasStatus(reply, "SUCCEEDED"));
+    }
+
+    // a redelivery while the reply is pending is ignored
+    deliverCommand(broker, "deferred");
+    loopFor(thing, 100);
+    deliverCommand(broker, "deferred", true);
+    loopFor(thing, 100);
+    CHECK(deferredCalls == 1);
+    CHECK(responses(broker, "deferred").empty());
+
+    CommandReply reply{
+        .status = "SUCCEEDED",
+    };
+    thing.commandReply("deferred", reply);
+    loopFor(thing, 100);
+    CHECK(responses(broker, "deferred").size() == 1);
+
+    deliverCommand(broker, "deferred", true);
+    loopFor(thing, 100);
+    CHECK(deferredCalls == 1);
+    CHECK(responses(broker, "deferred").size() == 2);
+}
+
+static void testExecutorRejectsAndTimesOut() {
+    BrokerStandIn broker(0);
+    CHECK(broker.start());
+
+    const unsigned long timeoutMs = 300;
+    std::atomic<bool> unblocked(false);
+    std::atomic<int> calls(0);
+    std::atomic<int> finished(0);
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    thing.setCommandCallback([&](const String &executionId, JsonDocument &payload) -> bool {
+        calls++;
+        while (!unblocked) {
+            delay(5);
+        }
+        CommandReply reply{
+            .status = "SUCCEEDED",
+        };
+        thing.commandReply(executionId, reply);
+        finished++;
+        return true;
+    });
+    CHECK(thing.setCommandExecutor(2, timeoutMs));
+    CHECK(connect(thing, broker));
+
+    // both slots are busy, the third command is rejected without running
+    deliverCommand(broker, "first");
+    deliverCommand(broker, "second");
+    loopFor(thing, 100);
+    deliverCommand(broker, "third");
+    loopFor(thing, 100);
+    CHECK(calls == 2);
+    std::vector<BrokerMessage> rejected = responses(broker, "third");
+    CHECK(rejected.size() == 1 && hasStatus(rejected[0], "REJECTED"));
+    CHECK(responses(broker, "first").empty());
+
+    // past the deadline both running commands are answered with a timeout
+    loopFor(thing, timeoutMs);
+    for (const char *executionId: {"first", "second"}) {
+        std::vector<BrokerMessage> replies = responses(broker, executionId);
+        CHECK(replies.size() == 1 && hasStatus(replies[0], "TIMED_OUT"));
+    }
+
+    // their late replies are dropped
+    unblocked = true;
+    while (finished < 2) {
+        delay(5);
+    }
+    loopFor(thing, 100);
+    for (const char *executionId: {"first", "second"}) {
+        std::vector<BrokerMessage> replies = responses(broker, executionId);
+        CHECK(replies.size() == 1 && hasStatus(replies[0], "TIMED_OUT"));
+    }
+    CHECK(calls == 2);
+}
+
+int main() {
+    testRedeliveryWithoutExecutor();
+    testExecutorRejectsAndTimesOut();
+
+    if (failures > 0) {
+        fprintf(stderr, "[FAIL] %d checks failed\n", failures);
+        return 1;
+    }
+
+    Serial.println("[INFO] Command dedupe checks passed");
+    return 0;
+}
@@ -0,0 +1,206 @@
+//
+// Created by yunarta on 10/18/26.
+//
+// Runs endpoint probing and failover end to end through IdentityShadowThing::begin(), loop()
+// and the real connect path against local broker stand-ins with injected handshake delays.
+// Nothing is expected to listen on 127.0.0.1:8883, the constructor endpoint.
+//
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "BrokerStandIn.h"
+#include "IdentityShadowThing.h"
+
+static int failures = 0;
+
+// PubSubClient reads one packet per loop, a dropped connection is only noticed once the
+// acknowledgements still buffered in the socket have been read
+static const int DRAIN_LOOPS = 20;
+
+#define CHECK(condition)                                                     \
+    do {                                                                     \
+        if (!(condition)) {                                                  \
+            fprintf(stderr, "[FAIL] %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            failures++;                                                      \
+        }                                                                    \
+    } while (0)
+
+static String stickyEndpoint() {
+    Preferences preferences;
+    preferences.begin("aws-iot", true);
+    String endpoint = preferences.getString("endpoint", "");
+    preferences.end();
+    return endpoint;
+}
+
+static bool loopUntil(IdentityShadowThing &thing, int state, int attempts) {
+    for (int i = 0; i < attempts; i++) {
+        thing.loop();
+        CHECK(thing.getConnectionState() != TIMEOUT);
+        if (thing.getConnectionState() == state) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void testProbeFailoverAndReprobe() {
+    Preferences::hostReset();
+    BrokerStandIn slow(IDENTITY_ENDPOINT_SLOW_MS + 200);
+    BrokerStandIn fast(20);
+    CHECK(slow.start());
+    CHECK(fast.start());
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    thing.addEndpoint(LOCALHOST, slow.getPort());
+    thing.addEndpoint(LOCALHOST, fast.getPort());
+
+    // no sticky endpoint: probe, connect to the winner and keep it for the next boot
+    thing.begin();
+    CHECK(thing.getEndpoint().equals(fast.getKey()));
+    CHECK(stickyEndpoint().equals(fast.getKey()));
+    CHECK(loopUntil(thing, CONNECTED, 1));
+    CHECK(fast.getSessions() == 1);
+    CHECK(slow.getSessions() == 0);
+
+    // the sticky endpoint is used on the next boot without probing
+    {
+        unsigned long probes = slow.getAccepted();
+        IdentityShadowThing rebooted(LOCALHOST, "HostTemplate");
+        rebooted.addEndpoint(LOCALHOST, slow.getPort());
+        rebooted.addEndpoint(LOCALHOST, fast.getPort());
+        rebooted.begin();
+        CHECK(rebooted.getEndpoint().equals(fast.getKey()));
+        CHECK(slow.getAccepted() == probes);
+    }
+
+    // outage: failover after IDENTITY_ENDPOINT_MAX_FAILURES re-probes, the slow endpoint wins
+    fast.stop();
+    CHECK(loopUntil(thing, CONNECTING, DRAIN_LOOPS));
+    CHECK(loopUntil(thing, CONNECTED, IDENTITY_ENDPOINT_MAX_FAILURES + 2));
+    CHECK(thing.getEndpoint().equals(slow.getKey()));
+    CHECK(stickyEndpoint().equals(slow.getKey()));
+    CHECK(slow.getSessions() == 1);
+
+    // the slow connect schedules a re-probe, the recovered fast endpoint wins on reconnect
+    CHECK(fast.start(fast.getPort()));
+    slow.dropConnections();
+    for (int i = 0; i < DRAIN_LOOPS && fast.getSessions() < 2; i++) {
+        thing.loop();
+    }
+    CHECK(thing.getConnectionState() == CONNECTED);
+    CHECK(thing.getEndpoint().equals(fast.getKey()));
+    CHECK(stickyEndpoint().equals(fast.getKey()));
+    CHECK(fast.getSessions() == 2);
+    CHECK(slow.getSessions() == 1);
+}
+
+static void testFailoverSkipsFailedEndpoints() {
+    Preferences::hostReset();
+    BrokerStandIn refusing(20);
+    BrokerStandIn healthy(100);
+    CHECK(refusing.start());
+    CHECK(healthy.start());
+    refusing.refuseSessions(true);
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    thing.addEndpoint(LOCALHOST, refusing.getPort());
+    thing.addEndpoint(LOCALHOST, healthy.getPort());
+
+    // the refusing endpoint wins the probe, its handshake works but every MQTT connect fails
+    thing.begin();
+    CHECK(thing.getEndpoint().equals(refusing.getKey()));
+    CHECK(refusing.getAccepted() == 1);
+
+    // failover probes only the endpoints that have not failed, then connects to the healthy one
+    CHECK(loopUntil(thing, CONNECTED, IDENTITY_ENDPOINT_MAX_FAILURES + 2));
+    CHECK(thing.getEndpoint().equals(healthy.getKey()));
+    CHECK(stickyEndpoint().equals(healthy.getKey()));
+    CHECK(refusing.getAccepted() == 1 + IDENTITY_ENDPOINT_MAX_FAILURES);
+    CHECK(healthy.getSessions() == 1);
+}
+
+static void testStalledHandshakeIsBounded() {
+    Preferences::hostReset();
+    BrokerStandIn stalled(0, true);
+    CHECK(stalled.start());
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    thing.addEndpoint(LOCALHOST, stalled.getPort());
+    const unsigned long handshakeMs = IDENTITY_ENDPOINT_HANDSHAKE_TIMEOUT * 1000UL;
+
+    // both probes give up, the stalled one after the handshake timeout
+    unsigned long start = millis();
+    thing.begin();
+    unsigned long elapsed = millis() - start;
+    CHECK(elapsed >= handshakeMs - 100);
+    CHECK(elapsed < handshakeMs + 1000);
+    CHECK(stickyEndpoint().length() == 0);
+
+    // fail over onto the stalled endpoint and try it, a loop never blocks for longer than
+    // a re-probe plus one connect
+    for (int i = 0; i <= IDENTITY_ENDPOINT_MAX_FAILURES; i++) {
+        start = millis();
+        thing.loop();
+        CHECK(millis() - start < 2 * handshakeMs + 1000);
+        CHECK(thing.getConnectionState() == CONNECTING);
+    }
+    CHECK(thing.getEndpoint().equals(stalled.getKey()));
+
+    // once every endpoint failed there is no probing, only connect attempts reach the stand-in
+    unsigned long accepted = stalled.getAccepted();
+    for (int i = 1; i < IDENTITY_ENDPOINT_MAX_FAILURES; i++) {
+        thing.loop();
+    }
+    CHECK(thing.getEndpoint().equals(String(LOCALHOST) + ":8883"));
+    CHECK(stalled.getAccepted() == accepted + IDENTITY_ENDPOINT_MAX_FAILURES - 1);
+}
+
+static void testConnectionWindowPerEndpoint() {
+    Preferences::hostReset();
+    BrokerStandIn down(0);
+    CHECK(down.start());
+    down.stop();
+
+    IdentityShadowThing thing(LOCALHOST, "HostTemplate");
+    thing.addEndpoint(LOCALHOST, down.getPort());
+
+    hostClockManual(0);
+    thing.begin();
+
+    // the first endpoint uses most of its window, then fails over
+    hostClockAdvance(100000);
+    for (int i = 0; i < IDENTITY_ENDPOINT_MAX_FAILURES; i++) {
+        thing.loop();
+    }
+    CHECK(thing.getEndpoint().equals(down.getKey()));
+
+    // switching endpoints restarted the window
+    hostClockAdvance(30000);
+    thing.loop();
+    CHECK(thing.getConnectionState() == CONNECTING);
+
+    // once every endpoint failed the window is not restarted again
+    for (int i = 1; i < IDENTITY_ENDPOINT_MAX_FAILURES; i++) {
+        thing.loop();
+    }
+    hostClockAdvance(120000);
+    thing.loop();
+    CHECK(thing.getConnectionState() == TIMEOUT);
+}
+
+int main() {
+    testProbeFailoverAndReprobe();
+    testFailoverSkipsFailedEndpoints();
+    testStalledHandshakeIsBounded();
+    testConnectionWindowPerEndpoint();
+
+    if (failures > 0) {
+        fprintf(stderr, "[FAIL] %d checks failed\n", failures);
+        return 1;
+    }
+
+    Serial.println("[INFO] Endpoint failover checks passed");
+    return 0;
+}
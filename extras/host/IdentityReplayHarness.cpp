@@ -0,0 +1,178 @@
+//
+// Created by yunarta on 10/18/26.
+//
+// Replays traces through IdentityShadowThing on the host and reports heap, latency and
+// throughput per pass. The whole process runs on HostHeap, a fixed size device-like heap,
+// so fragmentation that builds up over many passes shows in the largest free block.
+//
+// usage: identity_replay [options] <trace>...
+//   --passes N             replay every trace N times (default 1)
+//   --realtime             keep the recorded timing instead of running at full speed
+//   --unprovisioned        start without credentials, for provisioning traces
+//   --executor SLOTS       run commands on the command executor with SLOTS slots
+//   --command-timeout MS   command deadline for the executor (default 5000)
+//   --max-heap-growth B    fail when free heap after the last pass is B bytes below the first
+//   --quiet                only print the summary
+//
+
+#include <Arduino.h>
+#include <FS.h>
+#include <HostHeap.h>
+#include <Preferences.h>
+
+#include <cinttypes>
+#include <cstdlib>
+#include <vector>
+
+#include "IdentityShadowThing.h"
+#include "IdentityTrafficReplay.h"
+
+struct HarnessOptions {
+    unsigned long passes = 1;
+    bool realtime = false;
+    bool provisioned = true;
+    uint8_t executorSlots = 0;
+    unsigned long commandTimeout = 5000;
+    long maxHeapGrowth = -1;
+    bool quiet = false;
+    std::vector<const char *> traces;
+};
+
+static bool parseOptions(int argc, char **argv, HarnessOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        String argument(argv[i]);
+        bool hasValue = i + 1 < argc;
+
+        if (argument.equals("--passes") && hasValue) {
+            options.passes = strtoul(argv[++i], nullptr, 10);
+        } else if (argument.equals("--realtime")) {
+            options.realtime = true;
+        } else if (argument.equals("--unprovisioned")) {
+            options.provisioned = false;
+        } else if (argument.equals("--executor") && hasValue) {
+            options.executorSlots = strtoul(argv[++i], nullptr, 10);
+        } else if (argument.equals("--command-timeout") && hasValue) {
+            options.commandTimeout = strtoul(argv[++i], nullptr, 10);
+        } else if (argument.equals("--max-heap-growth") && hasValue) {
+            options.maxHeapGrowth = strtol(argv[++i], nullptr, 10);
+        } else if (argument.equals("--quiet")) {
+            options.quiet = true;
+        } else if (argument.startsWith("--")) {
+            return false;
+        } else {
+            options.traces.push_back(argv[i]);
+        }
+    }
+
+    return !options.traces.empty() && options.passes > 0;
+}
+
+int main(int argc, char **argv) {
+    HarnessOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [--passes N] [--realtime] [--unprovisioned] [--executor SLOTS]\n"
+                        "       [--command-timeout MS] [--max-heap-growth BYTES] [--quiet] <trace>...\n", argv[0]);
+        return 2;
+    }
+
+    // everything from here on, including the library under test, lives on the host heap
+    hostHeapEnable(true);
+
+    Preferences preferences;
+    preferences.begin("aws-iot", false);
+    preferences.putBool("provisioned", options.provisioned);
+    preferences.end();
+
+    auto *thing = new IdentityShadowThing("localhost", "HostTemplate");
+    thing->setCommandCallback([thing](const String &executionId, JsonDocument &payload) -> bool {
+        CommandReply reply{
+            .status = "SUCCEEDED",
+        };
+        thing->commandReply(executionId, reply);
+        return true;
+    });
+    thing->setJobCallback([thing](const String &jobId, JsonDocument &payload) -> bool {
+        JobReply reply{
+            .status = "SUCCEEDED",
+            .expectedVersion = payload["execution"]["versionNumber"].as<long>(),
+        };
+        thing->jobReply(jobId, reply);
+        return true;
+    });
+    thing->setMessageCallback([](const String &topic, JsonDocument &payload) -> bool {
+        return true;
+    });
+    if (options.executorSlots > 0) {
+        thing->setCommandExecutor(options.executorSlots, options.commandTimeout);
+    }
+    thing->begin();
+
+    fs::FS host("");
+    IdentityTrafficReplay replay(thing);
+    IdentityTrafficReport report;
+
+    uint32_t firstFreeHeap = 0;
+    uint32_t lastFreeHeap = 0;
+    uint32_t firstLargestBlock = 0;
+    uint32_t lastLargestBlock = 0;
+    unsigned long messages = 0;
+    unsigned long durationMs = 0;
+    uint32_t worstLatencyP99 = 0;
+
+    for (unsigned long pass = 0; pass < options.passes; pass++) {
+        for (const char *trace: options.traces) {
+            if (!replay.run(host, trace, options.realtime, report)) {
+                fprintf(stderr, "[ERROR] unable to replay %s\n", trace);
+                return 1;
+            }
+
+            if (!options.quiet) {
+                Serial.printf("[INFO] Pass %lu, %s\n", pass + 1, trace);
+                report.print(Serial);
+            }
+
+            messages += report.inbound;
+            durationMs += report.durationMs;
+            if (report.latencyP99Us > worstLatencyP99) {
+                worstLatencyP99 = report.latencyP99Us;
+            }
+        }
+
+        // executor tasks can still be running when a pass ends, sample once their allocations are gone
+        if (!replay.waitForCommands(options.commandTimeout)) {
+            fprintf(stderr, "[ERROR] commands still running %lu ms after the pass\n", options.commandTimeout);
+            return 1;
+        }
+        lastFreeHeap = ESP.getFreeHeap();
+        lastLargestBlock = ESP.getMaxAllocHeap();
+        if (pass == 0) {
+            firstFreeHeap = lastFreeHeap;
+            firstLargestBlock = lastLargestBlock;
+        }
+    }
+
+    HostHeapStats heap = hostHeapStats();
+    Serial.printf("[SUMMARY] %lu passes, %lu messages in %lu ms (%.1f msg/s), worst p99 %" PRIu32 " us\n",
+                  options.passes, messages, durationMs,
+                  durationMs > 0 ? messages * 1000.0 / durationMs : 0.0, worstLatencyP99);
+    Serial.printf("[SUMMARY] Free heap after first pass %" PRIu32 ", after last pass %" PRIu32
+                  ", minimum %zu of %zu\n", firstFreeHeap, lastFreeHeap, heap.minFreeBytes, heap.size);
+    Serial.printf("[SUMMARY] Largest free block after first pass %" PRIu32 ", after last pass %" PRIu32 "\n",
+                  firstLargestBlock, lastLargestBlock);
+    Serial.printf("[SUMMARY] Allocations %zu, failed to fit %zu\n", heap.allocations, heap.failures);
+    Serial.flush();
+
+    if (heap.failures > 0) {
+        fprintf(stderr, "[ERROR] %zu allocations did not fit the host heap\n", heap.failures);
+        return 1;
+    }
+
+    if (options.maxHeapGrowth >= 0 && firstFreeHeap > lastFreeHeap
+        && firstFreeHeap - lastFreeHeap > static_cast<uint32_t>(options.maxHeapGrowth)) {
+        fprintf(stderr, "[ERROR] free heap dropped by %" PRIu32 " bytes between the first and the last pass\n",
+                firstFreeHeap - lastFreeHeap);
+        return 1;
+    }
+
+    return 0;
+}
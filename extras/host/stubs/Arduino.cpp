@@ -0,0 +1,140 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "Arduino.h"
+#include "HostHeap.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+
+EspClass ESP;
+
+static const auto startedAt = std::chrono::steady_clock::now();
+static std::atomic<bool> manualClock(false);
+static std::atomic<unsigned long long> manualMicros(0);
+static std::atomic<unsigned long> restarts(0);
+static std::mt19937 generator(1);
+
+static unsigned long long elapsedMicros() {
+    if (manualClock) {
+        return manualMicros;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startedAt).count();
+}
+
+unsigned long millis() {
+    return elapsedMicros() / 1000;
+}
+
+unsigned long micros() {
+    return elapsedMicros();
+}
+
+void delay(unsigned long ms) {
+    if (manualClock) {
+        hostClockAdvance(ms);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long random(long max) {
+    return max > 0 ? random(0, max) : 0;
+}
+
+long random(long min, long max) {
+    if (max <= min) {
+        return min;
+    }
+    return std::uniform_int_distribution<long>(min, max - 1)(generator);
+}
+
+void randomSeed(unsigned long seed) {
+    generator.seed(seed);
+}
+
+void hostClockManual(unsigned long ms) {
+    manualMicros = static_cast<unsigned long long>(ms) * 1000;
+    manualClock = true;
+}
+
+void hostClockAdvance(unsigned long ms) {
+    manualMicros += static_cast<unsigned long long>(ms) * 1000;
+}
+
+void esp_restart() {
+    restarts++;
+    Serial.println(F("[HOST] esp_restart() called"));
+}
+
+void esp_deep_sleep_start() {
+    Serial.println(F("[HOST] esp_deep_sleep_start() called"));
+}
+
+unsigned long hostRestartCount() {
+    return restarts;
+}
+
+const char *EspClass::getChipModel() {
+    return "ESP32";
+}
+
+uint32_t EspClass::getFreeHeap() {
+    return hostHeapStats().freeBytes;
+}
+
+uint32_t EspClass::getMinFreeHeap() {
+    return hostHeapStats().minFreeBytes;
+}
+
+uint32_t EspClass::getMaxAllocHeap() {
+    return hostHeapStats().largestFreeBlock;
+}
+
+uint32_t EspClass::getHeapSize() {
+    return hostHeapStats().size;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    return new std::mutex();
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    static_cast<std::mutex *>(semaphore)->lock();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    static_cast<std::mutex *>(semaphore)->unlock();
+    return pdTRUE;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function,
+                       const char *name,
+                       uint32_t stackSize,
+                       void *parameter,
+                       unsigned int priority,
+                       TaskHandle_t *handle) {
+    std::thread task(function, parameter);
+    if (handle != nullptr) {
+        *handle = nullptr;
+    }
+    task.detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // returning from the task function ends the thread
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
@@ -0,0 +1,104 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Minimal Arduino-ESP32 surface used by IdentityShadowThing, enough to build and run
+// the library on a Linux host. Time comes from the steady clock unless a manual clock
+// is set, FreeRTOS tasks are std::threads and ESP heap figures come from HostHeap.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+
+// the stand-ins follow the arduino-esp32 3.x API
+#ifndef ESP_ARDUINO_VERSION_MAJOR
+#define ESP_ARDUINO_VERSION_MAJOR 3
+#endif
+
+#define F(text) (text)
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+
+unsigned long micros();
+
+void delay(unsigned long ms);
+
+void yield();
+
+long random(long max);
+
+long random(long min, long max);
+
+void randomSeed(unsigned long seed);
+
+// Freezes millis()/micros() at the given time until hostClockAdvance() moves it,
+// so tools can produce traces with exact timing.
+void hostClockManual(unsigned long ms);
+
+void hostClockAdvance(unsigned long ms);
+
+void esp_restart();
+
+void esp_deep_sleep_start();
+
+// number of esp_restart() calls, a restart does not end the host process
+unsigned long hostRestartCount();
+
+class EspClass {
+public:
+    const char *getChipModel();
+
+    uint32_t getFreeHeap();
+
+    uint32_t getMinFreeHeap();
+
+    uint32_t getMaxAllocHeap();
+
+    uint32_t getHeapSize();
+};
+
+extern EspClass ESP;
+
+typedef void *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdPASS 1
+#define pdFAIL 0
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xffffffffUL
+#define pdMS_TO_TICKS(ms) (ms)
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+
+BaseType_t xTaskCreate(TaskFunction_t function,
+                       const char *name,
+                       uint32_t stackSize,
+                       void *parameter,
+                       unsigned int priority,
+                       TaskHandle_t *handle);
+
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+
+#endif //HOST_ARDUINO_H
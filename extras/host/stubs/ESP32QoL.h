@@ -0,0 +1,39 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_ESP32QOL_H
+#define HOST_ESP32QOL_H
+
+#include <Arduino.h>
+
+#include <cstdarg>
+
+inline String StringPrintF(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (length < 0) {
+        return String();
+    }
+
+    std::string buffer(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&buffer[0], buffer.size(), format, args);
+    va_end(args);
+    buffer.resize(length);
+    return String(buffer);
+}
+
+// firmware updates are only logged on the host
+class OTAUpdateClass {
+public:
+    void begin(const String &version, const String &url) {
+        Serial.printf("[HOST] OTA update to %s from %s\n", version.c_str(), url.c_str());
+    }
+};
+
+inline OTAUpdateClass OTAUpdate;
+
+#endif //HOST_ESP32QOL_H
@@ -0,0 +1,149 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "FS.h"
+#include "LittleFS.h"
+
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+
+fs::LittleFSFS LittleFS;
+
+static std::string joinPath(const std::string &root, const char *path) {
+    if (root.empty()) {
+        return path;
+    }
+    return root + (path[0] == '/' ? "" : "/") + path;
+}
+
+static void makeParents(const std::string &path) {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        ::mkdir(path.substr(0, slash).c_str(), 0755);
+    }
+}
+
+fs::File::File(FILE *handle, const String &path) : handle(handle, fclose),
+                                                   filePath(path) {
+}
+
+size_t fs::File::write(uint8_t value) {
+    return handle ? fwrite(&value, 1, 1, handle.get()) : 0;
+}
+
+size_t fs::File::write(const uint8_t *buffer, size_t size) {
+    return handle ? fwrite(buffer, 1, size, handle.get()) : 0;
+}
+
+int fs::File::available() {
+    if (!handle) {
+        return 0;
+    }
+    size_t remaining = size() - position();
+    return remaining > INT32_MAX ? INT32_MAX : static_cast<int>(remaining);
+}
+
+int fs::File::read() {
+    return handle ? fgetc(handle.get()) : -1;
+}
+
+size_t fs::File::read(uint8_t *buffer, size_t size) {
+    return handle ? fread(buffer, 1, size, handle.get()) : 0;
+}
+
+int fs::File::peek() {
+    if (!handle) {
+        return -1;
+    }
+    int value = fgetc(handle.get());
+    if (value >= 0) {
+        ungetc(value, handle.get());
+    }
+    return value;
+}
+
+void fs::File::flush() {
+    if (handle) {
+        fflush(handle.get());
+    }
+}
+
+bool fs::File::seek(uint32_t position, SeekMode mode) {
+    static const int whence[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+    return handle && fseek(handle.get(), position, whence[mode]) == 0;
+}
+
+size_t fs::File::position() const {
+    return handle ? ftell(handle.get()) : 0;
+}
+
+size_t fs::File::size() const {
+    if (!handle) {
+        return 0;
+    }
+
+    struct stat info{};
+    return fstat(fileno(handle.get()), &info) == 0 ? info.st_size : 0;
+}
+
+void fs::File::close() {
+    handle.reset();
+}
+
+const char *fs::File::path() const {
+    return filePath.c_str();
+}
+
+fs::File::operator bool() const {
+    return handle != nullptr;
+}
+
+fs::FS::FS(const char *root) : root(root) {
+}
+
+void fs::FS::setRoot(const char *root) {
+    this->root = root;
+}
+
+fs::File fs::FS::open(const char *path, const char *mode, bool create) {
+    std::string hostPath = joinPath(root, path);
+    if (create || mode[0] != 'r') {
+        makeParents(hostPath);
+    }
+
+    // Arduino modes are text modes, the host reads and writes the bytes as they are
+    std::string hostMode = std::string(mode) + "b";
+    FILE *handle = fopen(hostPath.c_str(), hostMode.c_str());
+    if (handle == nullptr) {
+        return File();
+    }
+    return File(handle, path);
+}
+
+fs::File fs::FS::open(const String &path, const char *mode, bool create) {
+    return open(path.c_str(), mode, create);
+}
+
+bool fs::FS::exists(const char *path) {
+    return access(joinPath(root, path).c_str(), F_OK) == 0;
+}
+
+bool fs::FS::remove(const char *path) {
+    return ::remove(joinPath(root, path).c_str()) == 0;
+}
+
+bool fs::FS::mkdir(const char *path) {
+    std::string hostPath = joinPath(root, path);
+    makeParents(hostPath + "/");
+    return access(hostPath.c_str(), F_OK) == 0;
+}
+
+fs::LittleFSFS::LittleFSFS() : FS(getenv("IDENTITY_HOST_LITTLEFS") != nullptr
+                                      ? getenv("IDENTITY_HOST_LITTLEFS")
+                                      : "littlefs") {
+}
+
+bool fs::LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel) {
+    return mkdir("/");
+}
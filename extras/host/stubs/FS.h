@@ -0,0 +1,87 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <memory>
+#include <string>
+
+#include "Arduino.h"
+
+namespace fs {
+    enum SeekMode {
+        SeekSet = 0,
+        SeekCur = 1,
+        SeekEnd = 2
+    };
+
+    // Host stand-in for fs::File, a shared handle on a host FILE.
+    class File : public Stream {
+        std::shared_ptr<FILE> handle;
+        String filePath;
+
+    public:
+        File() = default;
+
+        File(FILE *handle, const String &path);
+
+        size_t write(uint8_t value) override;
+
+        size_t write(const uint8_t *buffer, size_t size) override;
+
+        using Print::write;
+
+        int available() override;
+
+        int read() override;
+
+        size_t read(uint8_t *buffer, size_t size);
+
+        int peek() override;
+
+        void flush() override;
+
+        bool seek(uint32_t position, SeekMode mode = SeekSet);
+
+        size_t position() const;
+
+        size_t size() const;
+
+        void close();
+
+        const char *path() const;
+
+        operator bool() const;
+    };
+
+    // Host stand-in for fs::FS, maps device paths below a host directory.
+    class FS {
+        std::string root;
+
+    public:
+        explicit FS(const char *root);
+
+        void setRoot(const char *root);
+
+        File open(const char *path, const char *mode = "r", bool create = false);
+
+        File open(const String &path, const char *mode = "r", bool create = false);
+
+        bool exists(const char *path);
+
+        bool remove(const char *path);
+
+        bool mkdir(const char *path);
+    };
+}
+
+using fs::FS;
+using fs::File;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+#endif //HOST_FS_H
@@ -0,0 +1,244 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "HostHeap.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifndef HOST_HEAP_SIZE
+#define HOST_HEAP_SIZE (256 * 1024)
+#endif
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void __libc_free(void *pointer);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_calloc(size_t count, size_t size);
+}
+
+// Every block carries a 16 byte header and an 8 byte footer holding its total size,
+// the lowest bit of the header marks it as used. Neighbours are found through the
+// header of the next block and the footer of the previous one, so free() coalesces in O(1).
+static const size_t ALIGNMENT = 16;
+static const size_t HEADER = 16;
+static const size_t FOOTER = sizeof(size_t);
+static const size_t MIN_BLOCK = 48;
+static const size_t USED = 1;
+
+alignas(ALIGNMENT) static uint8_t arena[HOST_HEAP_SIZE];
+static std::atomic_flag lock = ATOMIC_FLAG_INIT;
+static std::atomic<bool> enabled(false);
+static bool initialized = false;
+static size_t freeBytes = 0;
+static size_t minFreeBytes = 0;
+static size_t allocations = 0;
+static size_t failures = 0;
+
+class HeapLock {
+public:
+    HeapLock() {
+        while (lock.test_and_set(std::memory_order_acquire)) {
+        }
+    }
+
+    ~HeapLock() {
+        lock.clear(std::memory_order_release);
+    }
+};
+
+static size_t &headerOf(uint8_t *block) {
+    return *reinterpret_cast<size_t *>(block);
+}
+
+static size_t blockSize(uint8_t *block) {
+    return headerOf(block) & ~USED;
+}
+
+static bool isUsed(uint8_t *block) {
+    return (headerOf(block) & USED) != 0;
+}
+
+static void setBlock(uint8_t *block, size_t size, bool used) {
+    headerOf(block) = size | (used ? USED : 0);
+    *reinterpret_cast<size_t *>(block + size - FOOTER) = size;
+}
+
+static bool inArena(const void *pointer) {
+    auto *address = static_cast<const uint8_t *>(pointer);
+    return address >= arena && address < arena + sizeof(arena);
+}
+
+static void initialize() {
+    if (!initialized) {
+        setBlock(arena, sizeof(arena), false);
+        freeBytes = sizeof(arena);
+        minFreeBytes = freeBytes;
+        initialized = true;
+    }
+}
+
+static void *arenaAllocate(size_t size) {
+    initialize();
+
+    size_t needed = (size + HEADER + FOOTER + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if (needed < MIN_BLOCK) {
+        needed = MIN_BLOCK;
+    }
+
+    for (uint8_t *block = arena; block < arena + sizeof(arena); block += blockSize(block)) {
+        size_t available = blockSize(block);
+        if (isUsed(block) || available < needed) {
+            continue;
+        }
+
+        if (available - needed >= MIN_BLOCK) {
+            setBlock(block, needed, true);
+            setBlock(block + needed, available - needed, false);
+        } else {
+            needed = available;
+            setBlock(block, needed, true);
+        }
+
+        freeBytes -= needed;
+        if (freeBytes < minFreeBytes) {
+            minFreeBytes = freeBytes;
+        }
+        allocations++;
+        return block + HEADER;
+    }
+
+    return nullptr;
+}
+
+static size_t arenaCapacity(void *pointer) {
+    return blockSize(static_cast<uint8_t *>(pointer) - HEADER) - HEADER - FOOTER;
+}
+
+static void arenaFree(void *pointer) {
+    uint8_t *block = static_cast<uint8_t *>(pointer) - HEADER;
+    size_t size = blockSize(block);
+    freeBytes += size;
+
+    uint8_t *next = block + size;
+    if (next < arena + sizeof(arena) && !isUsed(next)) {
+        size += blockSize(next);
+    }
+
+    if (block > arena) {
+        size_t previousSize = *reinterpret_cast<size_t *>(block - FOOTER);
+        uint8_t *previous = block - previousSize;
+        if (!isUsed(previous)) {
+            block = previous;
+            size += previousSize;
+        }
+    }
+
+    setBlock(block, size, false);
+}
+
+void hostHeapEnable(bool value) {
+    HeapLock guard;
+    initialize();
+    enabled = value;
+}
+
+HostHeapStats hostHeapStats() {
+    HeapLock guard;
+    initialize();
+
+    size_t largest = 0;
+    for (uint8_t *block = arena; block < arena + sizeof(arena); block += blockSize(block)) {
+        if (!isUsed(block) && blockSize(block) - HEADER - FOOTER > largest) {
+            largest = blockSize(block) - HEADER - FOOTER;
+        }
+    }
+
+    return HostHeapStats{
+        .size = sizeof(arena),
+        .freeBytes = freeBytes,
+        .minFreeBytes = minFreeBytes,
+        .largestFreeBlock = largest,
+        .allocations = allocations,
+        .failures = failures,
+    };
+}
+
+extern "C" {
+void *malloc(size_t size) {
+    if (enabled.load(std::memory_order_relaxed)) {
+        HeapLock guard;
+        void *pointer = arenaAllocate(size);
+        if (pointer != nullptr) {
+            return pointer;
+        }
+        failures++;
+    }
+
+    return __libc_malloc(size);
+}
+
+void free(void *pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+
+    if (inArena(pointer)) {
+        HeapLock guard;
+        arenaFree(pointer);
+        return;
+    }
+
+    __libc_free(pointer);
+}
+
+void *calloc(size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return nullptr;
+    }
+
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return __libc_calloc(count, size);
+    }
+
+    void *pointer = malloc(count * size);
+    if (pointer != nullptr) {
+        memset(pointer, 0, count * size);
+    }
+    return pointer;
+}
+
+void *realloc(void *pointer, size_t size) {
+    if (pointer == nullptr) {
+        return malloc(size);
+    }
+
+    if (!inArena(pointer)) {
+        return __libc_realloc(pointer, size);
+    }
+
+    if (size == 0) {
+        free(pointer);
+        return nullptr;
+    }
+
+    size_t capacity;
+    {
+        HeapLock guard;
+        capacity = arenaCapacity(pointer);
+    }
+    if (size <= capacity) {
+        return pointer;
+    }
+
+    void *resized = malloc(size);
+    if (resized != nullptr) {
+        memcpy(resized, pointer, capacity);
+        free(pointer);
+    }
+    return resized;
+}
+}
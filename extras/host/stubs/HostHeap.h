@@ -0,0 +1,29 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_HEAP_H
+#define HOST_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Fixed size first-fit heap that stands in for the device heap on the host.
+// Once enabled, malloc/free/realloc/calloc and therefore new/delete are served from
+// the arena, so free heap and largest free block behave like on a device: long runs
+// fragment the arena and the largest free block shrinks.
+// Allocations that do not fit fall back to the system heap and are counted as failures.
+struct HostHeapStats {
+    size_t size;
+    size_t freeBytes;
+    size_t minFreeBytes;
+    size_t largestFreeBlock;
+    size_t allocations;
+    size_t failures;
+};
+
+void hostHeapEnable(bool enabled);
+
+HostHeapStats hostHeapStats();
+
+#endif //HOST_HEAP_H
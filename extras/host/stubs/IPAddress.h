@@ -0,0 +1,39 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <cstdint>
+#include <cstdio>
+
+#include "WString.h"
+
+class IPAddress {
+    uint8_t octets[4];
+
+public:
+    IPAddress(): octets{0, 0, 0, 0} {
+    }
+
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth): octets{first, second, third, fourth} {
+    }
+
+    uint8_t operator[](int index) const {
+        return octets[index];
+    }
+
+    bool operator==(const IPAddress &other) const {
+        return octets[0] == other.octets[0] && octets[1] == other.octets[1]
+               && octets[2] == other.octets[2] && octets[3] == other.octets[3];
+    }
+
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(text);
+    }
+};
+
+#endif //HOST_IPADDRESS_H
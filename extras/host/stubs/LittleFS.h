@@ -0,0 +1,26 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+    // LittleFS on the host lives in the directory named by IDENTITY_HOST_LITTLEFS,
+    // or ./littlefs when it is not set.
+    class LittleFSFS : public FS {
+    public:
+        LittleFSFS();
+
+        bool begin(bool formatOnFail = false,
+                   const char *basePath = "/littlefs",
+                   uint8_t maxOpenFiles = 10,
+                   const char *partitionLabel = "spiffs");
+    };
+}
+
+extern fs::LittleFSFS LittleFS;
+
+#endif //HOST_LITTLEFS_H
@@ -0,0 +1,98 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "Preferences.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+
+static std::map<std::string, std::map<std::string, std::string>> &store() {
+    static auto *namespaces = new std::map<std::string, std::map<std::string, std::string>>();
+    return *namespaces;
+}
+
+static std::mutex storeMutex;
+
+bool Preferences::begin(const char *name, bool readOnly, const char *partitionLabel) {
+    this->name = name;
+    this->readOnly = readOnly;
+    started = true;
+    return true;
+}
+
+void Preferences::end() {
+    started = false;
+}
+
+bool Preferences::clear() {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    if (!started || readOnly) {
+        return false;
+    }
+    store()[name.c_str()].clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    if (!started || readOnly) {
+        return false;
+    }
+    return store()[name.c_str()].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    auto &values = store()[name.c_str()];
+    return started && values.find(key) != values.end();
+}
+
+size_t Preferences::putBool(const char *key, bool value) {
+    return putString(key, value ? "1" : "0") > 0 ? 1 : 0;
+}
+
+size_t Preferences::putLong(const char *key, long value) {
+    return putString(key, String(value)) > 0 ? sizeof(long) : 0;
+}
+
+size_t Preferences::putString(const char *key, const char *value) {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    if (!started || readOnly) {
+        return 0;
+    }
+    store()[name.c_str()][key] = value;
+    return strlen(value) + 1;
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+    return putString(key, value.c_str());
+}
+
+bool Preferences::getBool(const char *key, bool defaultValue) {
+    String value = getString(key, defaultValue ? "1" : "0");
+    return value.equals("1");
+}
+
+long Preferences::getLong(const char *key, long defaultValue) {
+    if (!isKey(key)) {
+        return defaultValue;
+    }
+    return getString(key).toInt();
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    auto &values = store()[name.c_str()];
+    auto value = values.find(key);
+    if (!started || value == values.end()) {
+        return defaultValue;
+    }
+    return String(value->second);
+}
+
+void Preferences::hostReset() {
+    std::lock_guard<std::mutex> guard(storeMutex);
+    store().clear();
+}
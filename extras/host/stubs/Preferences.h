@@ -0,0 +1,46 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include "Arduino.h"
+
+// In-memory Preferences shared by every instance in the process, so a second
+// IdentityShadowThing sees what the first stored, like after a reboot on a device.
+class Preferences {
+    String name;
+    bool started = false;
+    bool readOnly = false;
+
+public:
+    bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+
+    void end();
+
+    bool clear();
+
+    bool remove(const char *key);
+
+    bool isKey(const char *key);
+
+    size_t putBool(const char *key, bool value);
+
+    size_t putLong(const char *key, long value);
+
+    size_t putString(const char *key, const char *value);
+
+    size_t putString(const char *key, const String &value);
+
+    bool getBool(const char *key, bool defaultValue = false);
+
+    long getLong(const char *key, long defaultValue = 0);
+
+    String getString(const char *key, const String &defaultValue = String());
+
+    // drops every namespace, for tests that simulate a factory reset
+    static void hostReset();
+};
+
+#endif //HOST_PREFERENCES_H
@@ -0,0 +1,94 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "Print.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+HostSerial Serial;
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size-- > 0) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+size_t Print::write(const char *value) {
+    return value != nullptr ? write(reinterpret_cast<const uint8_t *>(value), strlen(value)) : 0;
+}
+
+size_t Print::printf(const char *format, ...) {
+    char text[256];
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0) {
+        return 0;
+    }
+
+    if (static_cast<size_t>(length) < sizeof(text)) {
+        return write(reinterpret_cast<const uint8_t *>(text), length);
+    }
+
+    std::string buffer(length + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&buffer[0], buffer.size(), format, args);
+    va_end(args);
+    return write(reinterpret_cast<const uint8_t *>(buffer.c_str()), length);
+}
+
+size_t Print::print(const char *value) {
+    return write(value);
+}
+
+size_t Print::print(const String &value) {
+    return write(reinterpret_cast<const uint8_t *>(value.c_str()), value.length());
+}
+
+size_t Print::print(char value) {
+    return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(int value) {
+    return printf("%d", value);
+}
+
+size_t Print::print(unsigned int value) {
+    return printf("%u", value);
+}
+
+size_t Print::print(long value) {
+    return printf("%ld", value);
+}
+
+size_t Print::print(unsigned long value) {
+    return printf("%lu", value);
+}
+
+size_t Print::print(double value) {
+    return printf("%.2f", value);
+}
+
+size_t Print::println() {
+    return write('\n');
+}
+
+size_t HostSerial::write(uint8_t value) {
+    return fwrite(&value, 1, 1, stdout);
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HostSerial::flush() {
+    fflush(stdout);
+}
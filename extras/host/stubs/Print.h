@@ -0,0 +1,69 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "WString.h"
+
+class Print {
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t value) = 0;
+
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    size_t write(const char *value);
+
+    size_t printf(const char *format, ...) __attribute__ ((format (printf, 2, 3)));
+
+    size_t print(const char *value);
+
+    size_t print(const String &value);
+
+    size_t print(char value);
+
+    size_t print(int value);
+
+    size_t print(unsigned int value);
+
+    size_t print(long value);
+
+    size_t print(unsigned long value);
+
+    size_t print(double value);
+
+    size_t println();
+
+    template<typename T>
+    size_t println(const T &value) {
+        size_t n = print(value);
+        return n + println();
+    }
+
+    virtual void flush() {
+    }
+};
+
+class HostSerial : public Print {
+public:
+    void begin(unsigned long baud) {
+    }
+
+    size_t write(uint8_t value) override;
+
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    using Print::write;
+
+    void flush() override;
+};
+
+extern HostSerial Serial;
+
+#endif //HOST_PRINT_H
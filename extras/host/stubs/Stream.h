@@ -0,0 +1,38 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+
+    virtual int read() = 0;
+
+    virtual int peek() = 0;
+
+    virtual size_t readBytes(uint8_t *buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int value = read();
+            if (value < 0) {
+                break;
+            }
+            buffer[count++] = static_cast<uint8_t>(value);
+        }
+        return count;
+    }
+
+    void setTimeout(unsigned long timeout) {
+        this->timeout = timeout;
+    }
+
+protected:
+    unsigned long timeout = 1000;
+};
+
+#endif //HOST_STREAM_H
@@ -0,0 +1,78 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "WString.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string formatInteger(unsigned long long value, bool negative, unsigned char base) {
+    if (base < 2 || base > 36) {
+        base = 10;
+    }
+
+    std::string digits;
+    do {
+        unsigned digit = value % base;
+        digits += static_cast<char>(digit < 10 ? '0' + digit : 'a' + digit - 10);
+        value /= base;
+    } while (value > 0);
+
+    if (negative) {
+        digits += '-';
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+    // Arduino only prints a sign for base 10
+    if (base == 10 && value < 0) {
+        return formatInteger(0ULL - static_cast<unsigned long long>(value), true, base);
+    }
+    return formatInteger(static_cast<unsigned long long>(value), false, base);
+}
+
+static std::string formatFloat(double value, unsigned int decimalPlaces) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.*f", decimalPlaces, value);
+    return text;
+}
+
+String::String(int value, unsigned char base) : buffer(formatSigned(value, base)) {
+}
+
+String::String(unsigned int value, unsigned char base) : buffer(formatInteger(value, false, base)) {
+}
+
+String::String(long value, unsigned char base) : buffer(formatSigned(value, base)) {
+}
+
+String::String(unsigned long value, unsigned char base) : buffer(formatInteger(value, false, base)) {
+}
+
+String::String(long long value, unsigned char base) : buffer(formatSigned(value, base)) {
+}
+
+String::String(unsigned long long value, unsigned char base) : buffer(formatInteger(value, false, base)) {
+}
+
+String::String(float value, unsigned int decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {
+}
+
+String::String(double value, unsigned int decimalPlaces) : buffer(formatFloat(value, decimalPlaces)) {
+}
+
+bool String::equalsIgnoreCase(const String &other) const {
+    return buffer.length() == other.buffer.length()
+           && std::equal(buffer.begin(), buffer.end(), other.buffer.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+long String::toInt() const {
+    return strtol(buffer.c_str(), nullptr, 10);
+}
@@ -0,0 +1,215 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Host stand-in for the Arduino String, backed by std::string so its heap use
+// goes through the same allocator hook as everything else.
+class String {
+    std::string buffer;
+
+public:
+    String() = default;
+
+    String(const char *value) : buffer(value != nullptr ? value : "") {
+    }
+
+    String(const char *value, size_t length) : buffer(value != nullptr ? std::string(value, length) : "") {
+    }
+
+    String(const std::string &value) : buffer(value) {
+    }
+
+    String(const String &other) = default;
+
+    String(String &&other) noexcept = default;
+
+    explicit String(char value) : buffer(1, value) {
+    }
+
+    explicit String(int value, unsigned char base = 10);
+
+    explicit String(unsigned int value, unsigned char base = 10);
+
+    explicit String(long value, unsigned char base = 10);
+
+    explicit String(unsigned long value, unsigned char base = 10);
+
+    explicit String(long long value, unsigned char base = 10);
+
+    explicit String(unsigned long long value, unsigned char base = 10);
+
+    explicit String(float value, unsigned int decimalPlaces = 2);
+
+    explicit String(double value, unsigned int decimalPlaces = 2);
+
+    String &operator=(const String &other) = default;
+
+    String &operator=(String &&other) noexcept = default;
+
+    String &operator=(const char *value) {
+        buffer = value != nullptr ? value : "";
+        return *this;
+    }
+
+    bool reserve(unsigned int size) {
+        buffer.reserve(size);
+        return true;
+    }
+
+    unsigned int length() const {
+        return buffer.length();
+    }
+
+    bool isEmpty() const {
+        return buffer.empty();
+    }
+
+    const char *c_str() const {
+        return buffer.c_str();
+    }
+
+    char charAt(unsigned int index) const {
+        return index < buffer.length() ? buffer[index] : 0;
+    }
+
+    char operator[](unsigned int index) const {
+        return charAt(index);
+    }
+
+    char &operator[](unsigned int index) {
+        return buffer[index];
+    }
+
+    bool concat(const String &value) {
+        buffer += value.buffer;
+        return true;
+    }
+
+    bool concat(const char *value) {
+        if (value == nullptr) {
+            return false;
+        }
+        buffer += value;
+        return true;
+    }
+
+    bool concat(const char *value, unsigned int length) {
+        if (value == nullptr) {
+            return false;
+        }
+        buffer.append(value, length);
+        return true;
+    }
+
+    bool concat(char value) {
+        buffer += value;
+        return true;
+    }
+
+    template<typename T>
+    bool concat(T value) {
+        return concat(String(value));
+    }
+
+    template<typename T>
+    String &operator+=(const T &value) {
+        concat(value);
+        return *this;
+    }
+
+    bool equals(const String &other) const {
+        return buffer == other.buffer;
+    }
+
+    bool equals(const char *other) const {
+        return buffer == (other != nullptr ? other : "");
+    }
+
+    bool equalsIgnoreCase(const String &other) const;
+
+    bool startsWith(const String &prefix) const {
+        return buffer.compare(0, prefix.buffer.length(), prefix.buffer) == 0;
+    }
+
+    bool endsWith(const String &suffix) const {
+        return buffer.length() >= suffix.buffer.length()
+               && buffer.compare(buffer.length() - suffix.buffer.length(), suffix.buffer.length(), suffix.buffer) == 0;
+    }
+
+    int indexOf(char value, unsigned int from = 0) const {
+        size_t index = buffer.find(value, from);
+        return index == std::string::npos ? -1 : static_cast<int>(index);
+    }
+
+    int indexOf(const String &value, unsigned int from = 0) const {
+        size_t index = buffer.find(value.buffer, from);
+        return index == std::string::npos ? -1 : static_cast<int>(index);
+    }
+
+    String substring(unsigned int from) const {
+        return from < buffer.length() ? String(buffer.substr(from)) : String();
+    }
+
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            std::swap(from, to);
+        }
+        return from < buffer.length() ? String(buffer.substr(from, to - from)) : String();
+    }
+
+    long toInt() const;
+
+    bool operator==(const String &other) const {
+        return equals(other);
+    }
+
+    bool operator==(const char *other) const {
+        return equals(other);
+    }
+
+    bool operator!=(const String &other) const {
+        return !equals(other);
+    }
+
+    bool operator!=(const char *other) const {
+        return !equals(other);
+    }
+
+    bool operator<(const String &other) const {
+        return buffer < other.buffer;
+    }
+};
+
+inline String operator+(const String &left, const String &right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline String operator+(const String &left, const char *right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+inline String operator+(const char *left, const String &right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+template<typename T>
+String operator+(const String &left, T right) {
+    String result(left);
+    result.concat(right);
+    return result;
+}
+
+#endif //HOST_WSTRING_H
@@ -0,0 +1,25 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include "Arduino.h"
+
+#define WL_CONNECTED 3
+
+class WiFiClass {
+public:
+    String macAddress() {
+        return "24:0A:C4:00:00:01";
+    }
+
+    int status() {
+        return WL_CONNECTED;
+    }
+};
+
+extern WiFiClass WiFi;
+
+#endif //HOST_WIFI_H
@@ -0,0 +1,176 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "WiFiClientSecure.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+WiFiClientSecure::WiFiClientSecure() = default;
+
+WiFiClientSecure::~WiFiClientSecure() {
+    stop();
+}
+
+bool WiFiClientSecure::loadCACert(Stream &stream, size_t size) {
+    return true;
+}
+
+bool WiFiClientSecure::loadCertificate(Stream &stream, size_t size) {
+    return true;
+}
+
+bool WiFiClientSecure::loadPrivateKey(Stream &stream, size_t size) {
+    return true;
+}
+
+void WiFiClientSecure::setAlpnProtocols(const char **alpnProtocols) {
+    this->alpnProtocols = alpnProtocols;
+}
+
+void WiFiClientSecure::setConnectionTimeout(uint32_t milliseconds) {
+    connectionTimeoutMs = milliseconds;
+}
+
+void WiFiClientSecure::setHandshakeTimeout(unsigned long handshakeTimeout) {
+    handshakeTimeoutMs = handshakeTimeout * 1000;
+}
+
+bool WiFiClientSecure::waitReadable(unsigned long timeoutMs) {
+    pollfd descriptor{.fd = socket, .events = POLLIN, .revents = 0};
+    return poll(&descriptor, 1, static_cast<int>(timeoutMs)) > 0;
+}
+
+int WiFiClientSecure::connect(IPAddress ip, uint16_t port) {
+    return connect(ip.toString().c_str(), port);
+}
+
+int WiFiClientSecure::connect(const char *host, uint16_t port) {
+    return connect(host, port, static_cast<int32_t>(connectionTimeoutMs));
+}
+
+int WiFiClientSecure::connect(const char *host, uint16_t port, int32_t timeout) {
+    stop();
+
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *address = nullptr;
+    if (getaddrinfo(host, String(port).c_str(), &hints, &address) != 0 || address == nullptr) {
+        return 0;
+    }
+
+    socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (socket < 0) {
+        freeaddrinfo(address);
+        return 0;
+    }
+
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+    int result = ::connect(socket, address->ai_addr, address->ai_addrlen);
+    freeaddrinfo(address);
+
+    if (result < 0 && errno == EINPROGRESS) {
+        pollfd descriptor{.fd = socket, .events = POLLOUT, .revents = 0};
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (poll(&descriptor, 1, timeout) <= 0
+            || getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &length) != 0
+            || error != 0) {
+            stop();
+            return 0;
+        }
+    } else if (result < 0) {
+        stop();
+        return 0;
+    }
+
+    // handshake: the stand-in answers with its first byte once it is done
+    if (!waitReadable(handshakeTimeoutMs) || peek() < 0) {
+        stop();
+        return 0;
+    }
+    read();
+    return 1;
+}
+
+size_t WiFiClientSecure::write(uint8_t value) {
+    return write(&value, 1);
+}
+
+size_t WiFiClientSecure::write(const uint8_t *buffer, size_t size) {
+    if (socket < 0) {
+        return 0;
+    }
+    ssize_t written = send(socket, buffer, size, MSG_NOSIGNAL);
+    return written > 0 ? written : 0;
+}
+
+int WiFiClientSecure::available() {
+    if (socket < 0) {
+        return 0;
+    }
+    uint8_t buffer[256];
+    ssize_t count = recv(socket, buffer, sizeof(buffer), MSG_PEEK | MSG_DONTWAIT);
+    return count > 0 ? static_cast<int>(count) : 0;
+}
+
+int WiFiClientSecure::read() {
+    uint8_t value;
+    return read(&value, 1) == 1 ? value : -1;
+}
+
+int WiFiClientSecure::read(uint8_t *buffer, size_t size) {
+    if (socket < 0) {
+        return -1;
+    }
+    ssize_t count = recv(socket, buffer, size, MSG_DONTWAIT);
+    return count > 0 ? static_cast<int>(count) : -1;
+}
+
+int WiFiClientSecure::peek() {
+    if (socket < 0) {
+        return -1;
+    }
+    uint8_t value;
+    return recv(socket, &value, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? value : -1;
+}
+
+void WiFiClientSecure::flush() {
+}
+
+void WiFiClientSecure::stop() {
+    if (socket >= 0) {
+        close(socket);
+        socket = -1;
+    }
+}
+
+uint8_t WiFiClientSecure::connected() {
+    if (socket < 0) {
+        return 0;
+    }
+
+    uint8_t value;
+    ssize_t count = recv(socket, &value, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (count == 0 || (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        stop();
+        return 0;
+    }
+    return 1;
+}
+
+WiFiClientSecure::operator bool() {
+    return connected();
+}
+
+const char *WiFiClientSecure::hostAlpnProtocol() {
+    return alpnProtocols != nullptr ? alpnProtocols[0] : nullptr;
+}
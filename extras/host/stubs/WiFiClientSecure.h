@@ -0,0 +1,74 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef HOST_WIFICLIENTSECURE_H
+#define HOST_WIFICLIENTSECURE_H
+
+#include "Client.h"
+#include "WiFi.h"
+
+// Host stand-in for WiFiClientSecure over a plain TCP socket. There is no TLS on the
+// host: the handshake is modelled as waiting for the first byte from the server, so a
+// local broker stand-in can inject handshake delays or stall it completely.
+// Timeouts follow arduino-esp32 3.x: setConnectionTimeout() in milliseconds for the TCP
+// connect, setHandshakeTimeout() in seconds, defaulting to 120 s like the real client.
+class WiFiClientSecure : public Client {
+    int socket = -1;
+    const char **alpnProtocols = nullptr;
+    // arduino-esp32 default connect timeout
+    uint32_t connectionTimeoutMs = 30000;
+    unsigned long handshakeTimeoutMs = 120 * 1000UL;
+
+    bool waitReadable(unsigned long timeoutMs);
+
+public:
+    WiFiClientSecure();
+
+    ~WiFiClientSecure() override;
+
+    bool loadCACert(Stream &stream, size_t size);
+
+    bool loadCertificate(Stream &stream, size_t size);
+
+    bool loadPrivateKey(Stream &stream, size_t size);
+
+    void setAlpnProtocols(const char **alpnProtocols);
+
+    void setConnectionTimeout(uint32_t milliseconds);
+
+    void setHandshakeTimeout(unsigned long handshakeTimeout);
+
+    int connect(IPAddress ip, uint16_t port) override;
+
+    int connect(const char *host, uint16_t port) override;
+
+    int connect(const char *host, uint16_t port, int32_t timeout);
+
+    size_t write(uint8_t value) override;
+
+    size_t write(const uint8_t *buffer, size_t size) override;
+
+    using Print::write;
+
+    int available() override;
+
+    int read() override;
+
+    int read(uint8_t *buffer, size_t size) override;
+
+    int peek() override;
+
+    void flush() override;
+
+    void stop() override;
+
+    uint8_t connected() override;
+
+    operator bool() override;
+
+    // ALPN protocols of the last connect, so tests can check what was negotiated
+    const char *hostAlpnProtocol();
+};
+
+#endif //HOST_WIFICLIENTSECURE_H
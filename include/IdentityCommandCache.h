@@ -0,0 +1,59 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef IDENTITYCOMMANDCACHE_H
+#define IDENTITYCOMMANDCACHE_H
+
+#include <Arduino.h>
+#include <AwsIoTCore.h>
+
+#ifndef IDENTITY_COMMAND_CACHE_SIZE
+#define IDENTITY_COMMAND_CACHE_SIZE 16
+#endif
+
+enum IdentityCommandState {
+    COMMAND_CACHE_FULL = -1,
+    COMMAND_UNKNOWN = 0,
+    COMMAND_RUNNING = 1,
+    COMMAND_REPLY_QUEUED = 2,
+    COMMAND_REPLIED = 3
+};
+
+// Bounded LRU of recently seen command executionIds and their replies, used to
+// answer QoS1 redeliveries without running the command a second time.
+// Replies that are queued but not yet published are never evicted.
+// All methods are safe to call from command worker tasks.
+class IdentityCommandCache {
+    struct Entry {
+        String executionId;
+        CommandReply reply;
+        IdentityCommandState state;
+        unsigned long lastUsed;
+    };
+
+    Entry entries[IDENTITY_COMMAND_CACHE_SIZE];
+    unsigned long clock;
+    SemaphoreHandle_t mutex;
+
+    Entry *find(const String &executionId);
+
+    Entry *evict();
+
+public:
+    IdentityCommandCache();
+
+    IdentityCommandState track(const String &executionId, CommandReply &cached);
+
+    IdentityCommandState getState(const String &executionId);
+
+    bool complete(const String &executionId, const CommandReply &reply);
+
+    void forget(const String &executionId);
+
+    void clear();
+
+    bool nextQueued(String &executionId, CommandReply &reply);
+};
+
+#endif //IDENTITYCOMMANDCACHE_H
@@ -0,0 +1,66 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef IDENTITYCOMMANDEXECUTOR_H
+#define IDENTITYCOMMANDEXECUTOR_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <functional>
+
+#ifndef IDENTITY_COMMAND_EXECUTOR_SLOTS
+#define IDENTITY_COMMAND_EXECUTOR_SLOTS 4
+#endif
+
+#ifndef IDENTITY_COMMAND_EXECUTOR_STACK
+#define IDENTITY_COMMAND_EXECUTOR_STACK (6 * 1024)
+#endif
+
+// Runs command callbacks on their own FreeRTOS tasks, at most `concurrency` at a time.
+// A slot stays taken until its command is released by a reply, its callback returns false,
+// or its deadline passes, so a callback that returns true and replies later keeps its deadline.
+// A task cannot be killed safely, so an expired command keeps its slot until the
+// callback returns; expire() only reports it once so the caller can reply TIMED_OUT.
+class IdentityCommandExecutor {
+    enum SlotState {
+        SLOT_FREE = 0,
+        SLOT_RUNNING = 1,
+        SLOT_AWAITING_REPLY = 2,
+        SLOT_EXPIRED = 3
+    };
+
+    struct Slot {
+        IdentityCommandExecutor *executor;
+        String executionId;
+        JsonDocument payload;
+        unsigned long startedAt;
+        volatile SlotState state;
+        volatile bool replied;
+    };
+
+    std::function<bool(const String &executionId, JsonDocument &payload)> callback;
+    uint8_t concurrency;
+    unsigned long timeoutMs;
+
+    Slot slots[IDENTITY_COMMAND_EXECUTOR_SLOTS];
+    SemaphoreHandle_t mutex;
+
+    static void slotEntryPoint(void *p);
+
+public:
+    IdentityCommandExecutor(std::function<bool(const String &executionId, JsonDocument &payload)> callback,
+                            uint8_t concurrency,
+                            unsigned long timeoutMs);
+
+    bool submit(const String &executionId, JsonDocument &payload);
+
+    void release(const String &executionId);
+
+    void expire(std::function<void(const String &executionId)> onTimeout);
+
+    // true when no command is running, awaiting its reply or waiting for an expired task to return
+    bool isIdle();
+};
+
+#endif //IDENTITYCOMMANDEXECUTOR_H
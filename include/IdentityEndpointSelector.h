@@ -0,0 +1,91 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef IDENTITYENDPOINTSELECTOR_H
+#define IDENTITYENDPOINTSELECTOR_H
+
+#include <Arduino.h>
+#include <functional>
+
+#ifndef IDENTITY_ENDPOINT_MAX
+#define IDENTITY_ENDPOINT_MAX 4
+#endif
+
+#if IDENTITY_ENDPOINT_MAX > 8
+#error "IDENTITY_ENDPOINT_MAX must fit the 8 bit failed endpoint mask"
+#endif
+
+#ifndef IDENTITY_ENDPOINT_MAX_FAILURES
+#define IDENTITY_ENDPOINT_MAX_FAILURES 3
+#endif
+
+// TCP connect timeout in milliseconds, for probes and MQTT connects.
+// arduino-esp32 2.x only bounds MQTT connects in whole seconds, rounded up.
+#ifndef IDENTITY_ENDPOINT_CONNECT_TIMEOUT
+#define IDENTITY_ENDPOINT_CONNECT_TIMEOUT 5000
+#endif
+
+// TLS handshake timeout in seconds, the client default of 120 s would stall the loop
+#ifndef IDENTITY_ENDPOINT_HANDSHAKE_TIMEOUT
+#define IDENTITY_ENDPOINT_HANDSHAKE_TIMEOUT 10
+#endif
+
+// a successful connect slower than this triggers a re-probe at the next reconnect
+#ifndef IDENTITY_ENDPOINT_SLOW_MS
+#define IDENTITY_ENDPOINT_SLOW_MS 3000
+#endif
+
+struct IdentityEndpoint {
+    String host;
+    uint16_t port;
+    String alpn;
+    const char *alpnProtocols[2];
+    long latencyMs;
+};
+
+// Measures connect and handshake latency of an endpoint, returns -1 when it is unreachable.
+#define IdentityEndpointProbe std::function<long(const IdentityEndpoint &endpoint)>
+
+// Ordered list of MQTT endpoints. Endpoints are tried fastest first once probed,
+// and the selector moves to the next one after consecutive connection failures.
+// Endpoints that failed since the last successful connect are skipped, by probes as well,
+// until every endpoint has failed once, at which point the selector is exhausted and starts over.
+class IdentityEndpointSelector {
+    IdentityEndpoint endpoints[IDENTITY_ENDPOINT_MAX];
+    uint8_t order[IDENTITY_ENDPOINT_MAX];
+    uint8_t count;
+    uint8_t current;
+    uint8_t failures;
+    uint8_t failedMask;
+    bool exhausted;
+
+    uint8_t nextCandidate(uint8_t from);
+
+    IdentityEndpointProbe probe;
+
+public:
+    IdentityEndpointSelector();
+
+    bool add(const char *host, uint16_t port, const char *alpn);
+
+    void setProbe(IdentityEndpointProbe probe);
+
+    bool probeAll();
+
+    bool select(const String &key);
+
+    bool onFailure();
+
+    void onSuccess();
+
+    bool isExhausted();
+
+    const IdentityEndpoint &getCurrent();
+
+    String getKey();
+
+    uint8_t getCount();
+};
+
+#endif //IDENTITYENDPOINTSELECTOR_H
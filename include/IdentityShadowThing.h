@@ -11,6 +11,11 @@
 #include <Preferences.h>
 #include <ArduinoJson.h>
 
+#include "IdentityCommandCache.h"
+#include "IdentityCommandExecutor.h"
+#include "IdentityEndpointSelector.h"
+#include "IdentityTrafficRecorder.h"
+
 extern const char *IDENTITY_THING_EVENT_IDENTITY;
 extern const char *IDENTITY_THING_EVENT_COMMAND;
 extern const char *IDENTITY_THING_EVENT_JOBS;
@@ -30,9 +35,11 @@ enum IdentityShadowThingConnectionState {
 };
 
 class IdentityShadowThing {
+    friend class IdentityTrafficReplay;
+
     String thingName;
     String provisioningName;
-    String awsEndPoint;
+    IdentityEndpointSelector endpoints;
 
     WiFiClientSecure securedClient;
     PubSubClient mqttClient;
@@ -45,12 +52,20 @@ class IdentityShadowThing {
 
     JsonDocument identity;
 
+    long probeEndpoint(const IdentityEndpoint &endpoint);
+
+    void probeEndpoints();
+
+    void applyEndpoint();
+
     void mqttCallback(const char *topic, uint8_t *payload, unsigned int length);
 
     bool provisioningCallback(const String &topic, JsonDocument &payload);
 
     bool thingCommandCallback(const String &executionId, JsonDocument &payload);
 
+    void processCommands();
+
     void updateFirmware(const String &jobId, JsonDocument &payload);
 
     bool thingJobsCallback(const String &jobId, JsonDocument &payload);
@@ -67,14 +82,23 @@ class IdentityShadowThing {
     IdentityCommandCallback commandCallback;
     IdentityMessageCallback messageCallback;
 
+    IdentityCommandCache commandCache;
+    IdentityCommandExecutor *commandExecutor;
+    IdentityTrafficRecorder *trafficRecorder;
+
     int connectionState;
     unsigned long startAttemptTime;
+    bool endpointProbePending;
     bool provisioned;
     bool identified;
 
 public:
     IdentityShadowThing(const char *awsEndPoint, const char *provisioningName);
 
+    void addEndpoint(const char *host, uint16_t port = 8883, const char *alpn = nullptr);
+
+    void setEndpointProbe(IdentityEndpointProbe probe);
+
     void begin();
 
     void connect();
@@ -87,8 +111,12 @@ public:
 
     void setCommandCallback(IdentityCommandCallback callback);
 
+    bool setCommandExecutor(uint8_t concurrency, unsigned long timeoutMs);
+
     void setJobCallback(IdentityJobCallback callback);
 
+    void setTrafficRecorder(IdentityTrafficRecorder *recorder);
+
     void setMessageCallback(IdentityMessageCallback callback);
 
     String createTopic(const String &subTopic);
@@ -109,6 +137,8 @@ public:
 
     String getThingName();
 
+    String getEndpoint();
+
     void mergeIdentity(JsonDocument identity);
 
     void commandReply(const String &executionId, const CommandReply &payload);
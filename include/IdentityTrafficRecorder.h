@@ -0,0 +1,51 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef IDENTITYTRAFFICRECORDER_H
+#define IDENTITYTRAFFICRECORDER_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+extern const uint8_t IDENTITY_TRAFFIC_MAGIC[4];
+extern const uint8_t IDENTITY_TRAFFIC_VERSION;
+
+enum IdentityTrafficDirection {
+    TRAFFIC_INBOUND = 'I',
+    TRAFFIC_OUTBOUND = 'O'
+};
+
+// Appends MQTT traffic seen by IdentityShadowThing to a compact binary trace.
+// File layout: "ISTT", version, then one record per message:
+// direction (1), delta ms since previous record (4), topic length (2),
+// payload length (4), topic bytes, payload bytes. Integers are little endian.
+// Recording is safe from the loop task and command worker tasks at the same time.
+class IdentityTrafficRecorder {
+    fs::FS &fs;
+    String path;
+    File file;
+    unsigned long lastRecordAt;
+    unsigned long records;
+    SemaphoreHandle_t mutex;
+
+    void writeRecord(IdentityTrafficDirection direction,
+                     const char *topic,
+                     const uint8_t *payload,
+                     unsigned int length);
+
+public:
+    IdentityTrafficRecorder(fs::FS &fs, const char *path);
+
+    bool begin();
+
+    void end();
+
+    void recordInbound(const char *topic, const uint8_t *payload, unsigned int length);
+
+    void recordOutbound(const char *topic, const uint8_t *payload, unsigned int length);
+
+    unsigned long getRecordCount();
+};
+
+#endif //IDENTITYTRAFFICRECORDER_H
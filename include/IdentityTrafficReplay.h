@@ -0,0 +1,76 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#ifndef IDENTITYTRAFFICREPLAY_H
+#define IDENTITYTRAFFICREPLAY_H
+
+#include <IdentityShadowThing.h>
+#include <FS.h>
+
+#ifndef IDENTITY_TRAFFIC_MAX_PAYLOAD
+#define IDENTITY_TRAFFIC_MAX_PAYLOAD (1024 * 4)
+#endif
+
+#ifndef IDENTITY_TRAFFIC_LATENCY_SAMPLES
+#define IDENTITY_TRAFFIC_LATENCY_SAMPLES 512
+#endif
+
+#ifndef IDENTITY_TRAFFIC_HEAP_SAMPLES
+#define IDENTITY_TRAFFIC_HEAP_SAMPLES 64
+#endif
+
+struct IdentityTrafficReport {
+    unsigned long inbound;
+    unsigned long outbound;
+    unsigned long skipped;
+    unsigned long durationMs;
+    float messagesPerSecond;
+
+    uint32_t latencyP50Us;
+    uint32_t latencyP90Us;
+    uint32_t latencyP99Us;
+    uint32_t latencyMaxUs;
+
+    uint32_t initialFreeHeap;
+    uint32_t peakHeapUsed;
+    uint32_t minLargestFreeBlock;
+
+    // largest free block over time, evenly spaced across the replay
+    uint32_t largestFreeBlock[IDENTITY_TRAFFIC_HEAP_SAMPLES];
+    uint8_t largestFreeBlockCount;
+
+    void print(Print &out);
+};
+
+// Pushes a trace written by IdentityTrafficRecorder through IdentityShadowThing's
+// MQTT callback, either with the recorded timing or as fast as possible,
+// and measures heap and callback latency while doing so.
+// Each run starts with an empty command dedupe cache and pauses an attached traffic recorder.
+// Replies generated by the replayed messages go to the live MQTT client, so replay
+// on a device that is disconnected or pointed at a test broker.
+class IdentityTrafficReplay {
+    IdentityShadowThing *shadowThing;
+
+    uint32_t latencies[IDENTITY_TRAFFIC_LATENCY_SAMPLES];
+    unsigned long latencyCount;
+    uint32_t heapStride;
+    uint32_t heapTick;
+
+    void recordLatency(uint32_t latencyUs);
+
+    void sampleHeap(IdentityTrafficReport &report);
+
+    uint32_t percentile(uint32_t *sorted, size_t count, uint8_t percent);
+
+public:
+    IdentityTrafficReplay(IdentityShadowThing *shadowThing);
+
+    bool run(fs::FS &fs, const char *path, bool realtime, IdentityTrafficReport &report);
+
+    // With a command executor, commands from the last run may still be on their tasks.
+    // Publishes their replies and timeouts until every slot is free, or timeoutMs has passed.
+    bool waitForCommands(unsigned long timeoutMs);
+};
+
+#endif //IDENTITYTRAFFICREPLAY_H
@@ -0,0 +1,167 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "IdentityCommandCache.h"
+
+IdentityCommandCache::IdentityCommandCache(): clock(0),
+                                              mutex(xSemaphoreCreateMutex()) {
+    for (auto &entry: entries) {
+        entry.state = COMMAND_UNKNOWN;
+        entry.lastUsed = 0;
+    }
+}
+
+IdentityCommandCache::Entry *IdentityCommandCache::find(const String &executionId) {
+    for (auto &entry: entries) {
+        if (entry.state != COMMAND_UNKNOWN && entry.executionId.equals(executionId)) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+IdentityCommandCache::Entry *IdentityCommandCache::evict() {
+    // prefer a free entry, then the oldest published reply, then the oldest running command;
+    // a queued reply is only dropped once it has been published
+    Entry *replied = nullptr;
+    Entry *running = nullptr;
+    for (auto &entry: entries) {
+        switch (entry.state) {
+            case COMMAND_UNKNOWN:
+                return &entry;
+            case COMMAND_REPLIED:
+                if (replied == nullptr || entry.lastUsed < replied->lastUsed) {
+                    replied = &entry;
+                }
+                break;
+            case COMMAND_RUNNING:
+                if (running == nullptr || entry.lastUsed < running->lastUsed) {
+                    running = &entry;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    Entry *oldest = replied != nullptr ? replied : running;
+#ifdef LOG_DEBUG
+    if (oldest != nullptr) {
+        Serial.printf("[DEBUG] Evicting command from cache: %s\n", oldest->executionId.c_str());
+    }
+#endif
+    return oldest;
+}
+
+IdentityCommandState IdentityCommandCache::track(const String &executionId, CommandReply &cached) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    IdentityCommandState state = COMMAND_UNKNOWN;
+    Entry *entry = find(executionId);
+    if (entry != nullptr) {
+        state = entry->state;
+        cached = entry->reply;
+    } else {
+        entry = evict();
+        if (entry == nullptr) {
+            xSemaphoreGive(mutex);
+            return COMMAND_CACHE_FULL;
+        }
+
+        entry->executionId = executionId;
+        entry->reply = CommandReply{};
+        entry->state = COMMAND_RUNNING;
+    }
+    entry->lastUsed = ++clock;
+
+    xSemaphoreGive(mutex);
+    return state;
+}
+
+IdentityCommandState IdentityCommandCache::getState(const String &executionId) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    Entry *entry = find(executionId);
+    IdentityCommandState state = entry != nullptr ? entry->state : COMMAND_UNKNOWN;
+
+    xSemaphoreGive(mutex);
+    return state;
+}
+
+bool IdentityCommandCache::complete(const String &executionId, const CommandReply &reply) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    bool accepted = true;
+    Entry *entry = find(executionId);
+    if (entry == nullptr) {
+        // reply for a command that was never tracked or has already been evicted
+        entry = evict();
+        if (entry == nullptr) {
+#ifdef LOG_INFO
+            Serial.printf("[INFO] Command cache full of unpublished replies, dropping: %s\n", executionId.c_str());
+#endif
+            accepted = false;
+        } else {
+            entry->executionId = executionId;
+        }
+    } else if (entry->state != COMMAND_RUNNING) {
+        // late reply, e.g. after the executor already answered with a timeout
+        accepted = false;
+    }
+
+    if (accepted) {
+        entry->reply = reply;
+        entry->state = COMMAND_REPLY_QUEUED;
+        entry->lastUsed = ++clock;
+    }
+
+    xSemaphoreGive(mutex);
+    return accepted;
+}
+
+void IdentityCommandCache::forget(const String &executionId) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    // only a command without a reply can be forgotten, so a redelivery runs it again
+    Entry *entry = find(executionId);
+    if (entry != nullptr && entry->state == COMMAND_RUNNING) {
+        entry->executionId = "";
+        entry->state = COMMAND_UNKNOWN;
+    }
+
+    xSemaphoreGive(mutex);
+}
+
+void IdentityCommandCache::clear() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    // unpublished replies survive, everything else is forgotten
+    for (auto &entry: entries) {
+        if (entry.state != COMMAND_REPLY_QUEUED) {
+            entry.executionId = "";
+            entry.state = COMMAND_UNKNOWN;
+        }
+    }
+
+    xSemaphoreGive(mutex);
+}
+
+bool IdentityCommandCache::nextQueued(String &executionId, CommandReply &reply) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    bool found = false;
+    for (auto &entry: entries) {
+        if (entry.state == COMMAND_REPLY_QUEUED) {
+            executionId = entry.executionId;
+            reply = entry.reply;
+            entry.state = COMMAND_REPLIED;
+            found = true;
+            break;
+        }
+    }
+
+    xSemaphoreGive(mutex);
+    return found;
+}
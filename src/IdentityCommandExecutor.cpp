@@ -0,0 +1,141 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "IdentityCommandExecutor.h"
+
+IdentityCommandExecutor::IdentityCommandExecutor(
+    std::function<bool(const String &executionId, JsonDocument &payload)> callback,
+    uint8_t concurrency,
+    unsigned long timeoutMs): callback(callback),
+                              concurrency(concurrency),
+                              timeoutMs(timeoutMs),
+                              mutex(xSemaphoreCreateMutex()) {
+    if (this->concurrency == 0 || this->concurrency > IDENTITY_COMMAND_EXECUTOR_SLOTS) {
+        this->concurrency = IDENTITY_COMMAND_EXECUTOR_SLOTS;
+    }
+
+    for (auto &slot: slots) {
+        slot.executor = this;
+        slot.startedAt = 0;
+        slot.state = SLOT_FREE;
+        slot.replied = false;
+    }
+}
+
+void IdentityCommandExecutor::slotEntryPoint(void *p) {
+    auto *slot = static_cast<Slot *>(p);
+    IdentityCommandExecutor *executor = slot->executor;
+
+    bool handled = false;
+    if (executor->callback != nullptr) {
+        handled = executor->callback(slot->executionId, slot->payload);
+    }
+
+    xSemaphoreTake(executor->mutex, portMAX_DELAY);
+    slot->payload.clear();
+    if (slot->state == SLOT_RUNNING && handled && !slot->replied) {
+        // the callback will reply later, keep the deadline running until it does
+        slot->state = SLOT_AWAITING_REPLY;
+    } else {
+        slot->state = SLOT_FREE;
+    }
+    xSemaphoreGive(executor->mutex);
+
+    vTaskDelete(nullptr);
+}
+
+bool IdentityCommandExecutor::submit(const String &executionId, JsonDocument &payload) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    Slot *slot = nullptr;
+    for (uint8_t i = 0; i < concurrency; i++) {
+        if (slots[i].state == SLOT_FREE) {
+            slot = &slots[i];
+            break;
+        }
+    }
+
+    if (slot != nullptr) {
+        slot->executionId = executionId;
+        slot->payload = payload;
+        slot->startedAt = millis();
+        slot->state = SLOT_RUNNING;
+        slot->replied = false;
+    }
+    xSemaphoreGive(mutex);
+
+    if (slot == nullptr) {
+#ifdef LOG_DEBUG
+        Serial.printf("[DEBUG] Command executor busy, rejecting executionId: %s\n", executionId.c_str());
+#endif
+        return false;
+    }
+
+    if (xTaskCreate(slotEntryPoint,
+                    "thingCommand", IDENTITY_COMMAND_EXECUTOR_STACK, slot, 1,
+                    nullptr) != pdPASS) {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+        slot->payload.clear();
+        slot->state = SLOT_FREE;
+        xSemaphoreGive(mutex);
+        return false;
+    }
+
+    return true;
+}
+
+void IdentityCommandExecutor::release(const String &executionId) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < concurrency; i++) {
+        if (!slots[i].executionId.equals(executionId)) {
+            continue;
+        }
+
+        if (slots[i].state == SLOT_RUNNING) {
+            slots[i].replied = true;
+        } else if (slots[i].state == SLOT_AWAITING_REPLY) {
+            slots[i].state = SLOT_FREE;
+        }
+    }
+    xSemaphoreGive(mutex);
+}
+
+void IdentityCommandExecutor::expire(std::function<void(const String &executionId)> onTimeout) {
+    String expired[IDENTITY_COMMAND_EXECUTOR_SLOTS];
+    uint8_t count = 0;
+
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < concurrency; i++) {
+        SlotState state = slots[i].state;
+        if ((state == SLOT_RUNNING || state == SLOT_AWAITING_REPLY)
+            && !slots[i].replied
+            && now - slots[i].startedAt >= timeoutMs) {
+            // an awaiting slot has no task left, so it can be reused right away
+            slots[i].state = state == SLOT_RUNNING ? SLOT_EXPIRED : SLOT_FREE;
+            expired[count++] = slots[i].executionId;
+        }
+    }
+    xSemaphoreGive(mutex);
+
+    for (uint8_t i = 0; i < count; i++) {
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Command timed out, executionId: %s\n", expired[i].c_str());
+#endif
+        onTimeout(expired[i]);
+    }
+}
+
+bool IdentityCommandExecutor::isIdle() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+    bool idle = true;
+    for (uint8_t i = 0; i < concurrency; i++) {
+        if (slots[i].state != SLOT_FREE) {
+            idle = false;
+            break;
+        }
+    }
+    xSemaphoreGive(mutex);
+    return idle;
+}
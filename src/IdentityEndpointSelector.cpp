@@ -0,0 +1,154 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "IdentityEndpointSelector.h"
+
+#include <climits>
+
+IdentityEndpointSelector::IdentityEndpointSelector(): count(0),
+                                                      current(0),
+                                                      failures(0),
+                                                      failedMask(0),
+                                                      exhausted(false),
+                                                      probe(nullptr) {
+}
+
+bool IdentityEndpointSelector::add(const char *host, uint16_t port, const char *alpn) {
+    if (count >= IDENTITY_ENDPOINT_MAX) {
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Endpoint list full, ignoring %s:%u\n", host, port);
+#endif
+        return false;
+    }
+
+    IdentityEndpoint &endpoint = endpoints[count];
+    endpoint.host = host;
+    endpoint.port = port;
+    endpoint.alpn = alpn != nullptr ? alpn : "";
+    endpoint.alpnProtocols[0] = endpoint.alpn.length() > 0 ? endpoint.alpn.c_str() : nullptr;
+    endpoint.alpnProtocols[1] = nullptr;
+    endpoint.latencyMs = -1;
+
+    order[count] = count;
+    count++;
+    return true;
+}
+
+void IdentityEndpointSelector::setProbe(IdentityEndpointProbe probe) {
+    this->probe = probe;
+}
+
+bool IdentityEndpointSelector::probeAll() {
+    if (probe == nullptr || count == 0) {
+        return false;
+    }
+
+    // endpoints that failed since the last successful connect are not candidates, skip them
+    bool reachable = false;
+    for (uint8_t i = 0; i < count; i++) {
+        if ((failedMask & (1 << i)) != 0) {
+            endpoints[i].latencyMs = -1;
+            continue;
+        }
+
+        endpoints[i].latencyMs = probe(endpoints[i]);
+        reachable = reachable || endpoints[i].latencyMs >= 0;
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Endpoint %s:%u latency: %ld ms\n",
+                      endpoints[i].host.c_str(), endpoints[i].port, endpoints[i].latencyMs);
+#endif
+    }
+
+    // insertion sort on latency, unreachable endpoints keep their configured order at the end
+    for (uint8_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    for (uint8_t i = 1; i < count; i++) {
+        uint8_t index = order[i];
+        long latency = endpoints[index].latencyMs < 0 ? LONG_MAX : endpoints[index].latencyMs;
+
+        int8_t j = i - 1;
+        while (j >= 0) {
+            long other = endpoints[order[j]].latencyMs < 0 ? LONG_MAX : endpoints[order[j]].latencyMs;
+            if (other <= latency) {
+                break;
+            }
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = index;
+    }
+
+    // the winner, unless it already failed since the last successful connect
+    current = nextCandidate(0);
+    failures = 0;
+    return reachable;
+}
+
+bool IdentityEndpointSelector::select(const String &key) {
+    for (uint8_t i = 0; i < count; i++) {
+        const IdentityEndpoint &endpoint = endpoints[order[i]];
+        if (key.equals(endpoint.host + ":" + endpoint.port)) {
+            current = i;
+            failures = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IdentityEndpointSelector::onFailure() {
+    if (++failures < IDENTITY_ENDPOINT_MAX_FAILURES || count < 2) {
+        return false;
+    }
+
+    failures = 0;
+    failedMask |= 1 << order[current];
+    if (failedMask == (1 << count) - 1) {
+        // every endpoint failed, start another round
+        exhausted = true;
+        failedMask = 0;
+    }
+
+    current = nextCandidate((current + 1) % count);
+#ifdef LOG_INFO
+    Serial.printf("[INFO] Failing over to endpoint %s\n", getKey().c_str());
+#endif
+    return true;
+}
+
+void IdentityEndpointSelector::onSuccess() {
+    failures = 0;
+    failedMask = 0;
+    exhausted = false;
+}
+
+bool IdentityEndpointSelector::isExhausted() {
+    return exhausted;
+}
+
+uint8_t IdentityEndpointSelector::nextCandidate(uint8_t from) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t position = (from + i) % count;
+        if ((failedMask & (1 << order[position])) == 0) {
+            return position;
+        }
+    }
+
+    return from;
+}
+
+const IdentityEndpoint &IdentityEndpointSelector::getCurrent() {
+    return endpoints[order[current]];
+}
+
+String IdentityEndpointSelector::getKey() {
+    const IdentityEndpoint &endpoint = getCurrent();
+    return endpoint.host + ":" + endpoint.port;
+}
+
+uint8_t IdentityEndpointSelector::getCount() {
+    return count;
+}
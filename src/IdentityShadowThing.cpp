@@ -8,13 +8,14 @@
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 
-#include "../../ESP32-QualityOfLife/include/ESP32QoL.h"
+#include <ESP32QoL.h>
 
 const char *AWS_IOT_NAMESPACE = "aws-iot";
 const char *AWS_IOT_CERTIFICATE = "/aws-iot/certificate.pem.crt";
 const char *AWS_IOT_PRIVATE_KEY = "/aws-iot/private.pem.key";
 const char *AWS_IOT_ROOT_CA = "/aws-iot/aws-root-ca.pem";
 const char *SHADOW_IDENTITY_KEY = "shadowIdentity";
+const char *ENDPOINT_KEY = "endpoint";
 const char *IDENTITY_SHADOW = "Identity";
 
 const char *IDENTITY_THING_EVENT_IDENTITY = "Identity";
@@ -25,7 +26,6 @@ const char *IDENTITY_THING_EVENT_PROVISIONED = "Provisioned";
 IdentityShadowThing::IdentityShadowThing(const char *awsEndPoint,
                                          const char *provisioningName): thingName(thingNameWithMac(ESP.getChipModel())),
                                                                         provisioningName(provisioningName),
-                                                                        awsEndPoint(awsEndPoint),
                                                                         mqttClient(securedClient),
                                                                         provisioningClient(nullptr),
                                                                         thingClient(nullptr),
@@ -34,10 +34,28 @@ IdentityShadowThing::IdentityShadowThing(const char *awsEndPoint,
                                                                         jobCallback(nullptr),
                                                                         commandCallback(nullptr),
                                                                         messageCallback(nullptr),
+                                                                        commandExecutor(nullptr),
+                                                                        trafficRecorder(nullptr),
                                                                         connectionState(CONNECTING),
                                                                         startAttemptTime(0),
+                                                                        endpointProbePending(false),
                                                                         provisioned(false),
                                                                         identified(false) {
+    endpoints.add(awsEndPoint, 8883, nullptr);
+    endpoints.setProbe([this](const IdentityEndpoint &endpoint) -> long {
+        return probeEndpoint(endpoint);
+    });
+
+    // bound connects and handshakes, an unreachable endpoint must not block failover
+#if defined(ESP_ARDUINO_VERSION_MAJOR) && ESP_ARDUINO_VERSION_MAJOR >= 3
+    securedClient.setConnectionTimeout(IDENTITY_ENDPOINT_CONNECT_TIMEOUT);
+    securedClient.setTimeout(IDENTITY_ENDPOINT_CONNECT_TIMEOUT);
+#else
+    // arduino-esp32 2.x takes seconds here, round up so a short timeout does not become 0
+    securedClient.setTimeout((IDENTITY_ENDPOINT_CONNECT_TIMEOUT + 999) / 1000);
+#endif
+    securedClient.setHandshakeTimeout(IDENTITY_ENDPOINT_HANDSHAKE_TIMEOUT);
+
 #ifdef LOG_INFO
     Serial.println(F("[INFO] IdentityShadowThing initialized"));
     Serial.printf("[INFO] awsEndPoint: %s\n", awsEndPoint);
@@ -94,7 +112,13 @@ void IdentityShadowThing::begin() {
     auto privateKey = LittleFS.open(AWS_IOT_PRIVATE_KEY, "r");
     securedClient.loadPrivateKey(privateKey, privateKey.size());
 
-    mqttClient.setServer(this->awsEndPoint.c_str(), 8883);
+    if (endpoints.getCount() > 1 && !endpoints.select(preferences.getString(ENDPOINT_KEY, ""))) {
+#ifdef LOG_INFO
+        Serial.println(F("[INFO] No sticky endpoint, probing endpoints"));
+#endif
+        probeEndpoints();
+    }
+    applyEndpoint();
 
     startAttemptTime = millis();
     connectionState = CONNECTING;
@@ -103,14 +127,62 @@ void IdentityShadowThing::begin() {
 #endif
 }
 
+long IdentityShadowThing::probeEndpoint(const IdentityEndpoint &endpoint) {
+    securedClient.setAlpnProtocols(endpoint.alpnProtocols[0] != nullptr
+                                       ? const_cast<const char **>(endpoint.alpnProtocols)
+                                       : nullptr);
+
+    // the connect timeout is passed in milliseconds on every framework version,
+    // the handshake is bounded by the timeout set in the constructor
+    unsigned long start = millis();
+    if (!securedClient.connect(endpoint.host.c_str(), endpoint.port, IDENTITY_ENDPOINT_CONNECT_TIMEOUT)) {
+        return -1;
+    }
+    long latency = millis() - start;
+
+    securedClient.stop();
+    return latency;
+}
+
+void IdentityShadowThing::probeEndpoints() {
+    // the probe winner becomes the sticky endpoint for the next boot
+    if (endpoints.probeAll()) {
+        preferences.putString(ENDPOINT_KEY, endpoints.getKey());
+    } else {
+        preferences.remove(ENDPOINT_KEY);
+    }
+}
+
+void IdentityShadowThing::applyEndpoint() {
+    const IdentityEndpoint &endpoint = endpoints.getCurrent();
+
+    securedClient.setAlpnProtocols(endpoint.alpnProtocols[0] != nullptr
+                                       ? const_cast<const char **>(endpoint.alpnProtocols)
+                                       : nullptr);
+    mqttClient.setServer(endpoint.host.c_str(), endpoint.port);
+#ifdef LOG_INFO
+    Serial.printf("[INFO] Using endpoint %s:%u\n", endpoint.host.c_str(), endpoint.port);
+#endif
+}
+
 void IdentityShadowThing::connect() {
 #ifdef LOG_INFO
     Serial.println(F("[INFO] Starting MQTT connection"));
 #endif
 
+    unsigned long connectStart = millis();
     if (mqttClient.connect(WiFi.macAddress().c_str())) {
         connectionState = CONNECTED;
 
+        endpoints.onSuccess();
+        if (endpoints.getCount() > 1 && millis() - connectStart > IDENTITY_ENDPOINT_SLOW_MS) {
+#ifdef LOG_INFO
+            Serial.printf("[INFO] Endpoint %s is slow, probing again on the next reconnect\n",
+                          endpoints.getKey().c_str());
+#endif
+            endpointProbePending = true;
+        }
+
 #ifdef LOG_INFO
         Serial.println(F("[INFO] MQTT connected"));
 #endif
@@ -133,6 +205,17 @@ void IdentityShadowThing::connect() {
 #ifdef LOG_DEBUG
         Serial.println(F("[DEBUG] MQTT connection failed, retrying..."));
 #endif
+        if (endpoints.onFailure()) {
+            if (!endpoints.isExhausted()) {
+                // probe the endpoints that have not failed yet, the fastest one becomes sticky,
+                // and every endpoint gets a full connection window before timing out
+                probeEndpoints();
+                startAttemptTime = millis();
+            }
+            // once every endpoint failed, go round robin without probing again
+            applyEndpoint();
+        }
+
         if (millis() - startAttemptTime >= 120000) {
             connectionState = TIMEOUT;
 #ifdef LOG_INFO
@@ -150,6 +233,12 @@ void IdentityShadowThing::loop() {
             startAttemptTime = millis();
         }
 
+        if (endpointProbePending) {
+            endpointProbePending = false;
+            probeEndpoints();
+            applyEndpoint();
+        }
+
 #ifdef LOG_DEBUG
         Serial.println(F("[DEBUG] MQTT disconnected, attempting reconnect"));
 #endif
@@ -162,6 +251,7 @@ void IdentityShadowThing::loop() {
         mqttClient.loop();
         if (provisioned) {
             thingClient->loop();
+            processCommands();
         }
     }
 }
@@ -171,6 +261,10 @@ void IdentityShadowThing::mqttCallback(const char *topic, uint8_t *payload, unsi
         signalCallback();
     }
 
+    if (trafficRecorder != nullptr) {
+        trafficRecorder->recordInbound(topic, payload, length);
+    }
+
     payload[length] = '\0';
     JsonDocument doc;
 
@@ -229,14 +323,74 @@ bool IdentityShadowThing::thingCommandCallback(const String &executionId, JsonDo
     Serial.printf("[DEBUG] Received callback for executionId: %s\n", executionId.c_str());
 #endif
 
+    CommandReply cached;
+    switch (commandCache.track(executionId, cached)) {
+        case COMMAND_REPLIED:
+#ifdef LOG_DEBUG
+            Serial.printf("[DEBUG] Duplicate executionId: %s, resending cached reply\n", executionId.c_str());
+#endif
+            thingClient->commandReply(executionId, cached);
+            return true;
+        case COMMAND_RUNNING:
+        case COMMAND_REPLY_QUEUED:
+#ifdef LOG_DEBUG
+            Serial.printf("[DEBUG] Duplicate executionId: %s, already in progress\n", executionId.c_str());
+#endif
+            return true;
+        case COMMAND_CACHE_FULL:
+#ifdef LOG_INFO
+            Serial.printf("[INFO] Command cache full, dropping executionId: %s\n", executionId.c_str());
+#endif
+            return false;
+        default:
+            break;
+    }
+
     if (this->eventCallback != nullptr) {
         eventCallback(IDENTITY_THING_EVENT_COMMAND);
     }
 
-    if (this->commandCallback != nullptr) {
-        commandCallback(executionId, payload);
+    if (this->commandExecutor != nullptr) {
+        if (!commandExecutor->submit(executionId, payload)) {
+            CommandReply reply{
+                .status = "REJECTED",
+            };
+            commandReply(executionId, reply);
+        }
+        return true;
+    }
+
+    if (this->commandCallback == nullptr) {
+        commandCache.forget(executionId);
+        return false;
+    }
+
+    // a command replying later stays running, redeliveries are ignored until it replies
+    bool handled = commandCallback(executionId, payload);
+    if (!handled) {
+        CommandReply reply{
+            .status = "FAILED",
+        };
+        commandReply(executionId, reply);
+    }
+    return handled;
+}
+
+void IdentityShadowThing::processCommands() {
+    if (this->commandExecutor != nullptr) {
+        commandExecutor->expire([this](const String &executionId) {
+            CommandReply reply{
+                .status = "TIMED_OUT",
+            };
+            commandCache.complete(executionId, reply);
+        });
+    }
+
+    String executionId;
+    CommandReply reply;
+    while (commandCache.nextQueued(executionId, reply)) {
+        thingClient->commandReply(executionId, reply);
     }
-    return false;
 }
 
 void IdentityShadowThing::updateFirmware(const String &jobId, JsonDocument &payload) {
@@ -399,6 +553,14 @@ bool IdentityShadowThing::thingMessageCallback(const String &topic, JsonDocument
     return false;
 }
 
+void IdentityShadowThing::addEndpoint(const char *host, uint16_t port, const char *alpn) {
+    endpoints.add(host, port, alpn);
+}
+
+void IdentityShadowThing::setEndpointProbe(IdentityEndpointProbe probe) {
+    endpoints.setProbe(probe);
+}
+
 void IdentityShadowThing::setEventCallback(IdentityEventCallback callback) {
     this->eventCallback = callback;
 }
@@ -415,6 +577,32 @@ void IdentityShadowThing::setCommandCallback(IdentityCommandCallback callback) {
     this->commandCallback = callback;
 }
 
+bool IdentityShadowThing::setCommandExecutor(uint8_t concurrency, unsigned long timeoutMs) {
+    // worker tasks keep pointers into the executor, so it can never be replaced
+    if (this->commandExecutor != nullptr) {
+#ifdef LOG_INFO
+        Serial.println(F("[INFO] Command executor already set"));
+#endif
+        return false;
+    }
+
+    this->commandExecutor = new IdentityCommandExecutor([this](const String &executionId, JsonDocument &payload) -> bool {
+        bool handled = this->commandCallback != nullptr && this->commandCallback(executionId, payload);
+        if (!handled) {
+            CommandReply reply{
+                .status = "FAILED",
+            };
+            commandReply(executionId, reply);
+        }
+        return handled;
+    }, concurrency, timeoutMs);
+    return true;
+}
+
+void IdentityShadowThing::setTrafficRecorder(IdentityTrafficRecorder *recorder) {
+    this->trafficRecorder = recorder;
+}
+
 void IdentityShadowThing::setMessageCallback(IdentityMessageCallback callback) {
     this->messageCallback = callback;
 }
@@ -444,6 +632,12 @@ void IdentityShadowThing::publish(const String &topic, JsonDocument &payload) {
     String stringPayload;
     serializeJson(payload, stringPayload);
 
+    if (trafficRecorder != nullptr) {
+        trafficRecorder->recordOutbound(topic.c_str(),
+                                        reinterpret_cast<const uint8_t *>(stringPayload.c_str()),
+                                        stringPayload.length());
+    }
+
     this->mqttClient.publish(topic.c_str(), stringPayload.c_str());
 }
 
@@ -467,6 +661,10 @@ String IdentityShadowThing::getThingName() {
     return this->thingName;
 }
 
+String IdentityShadowThing::getEndpoint() {
+    return endpoints.getKey();
+}
+
 void IdentityShadowThing::mergeIdentity(JsonDocument identity) {
     this->identity = identity;
     if (identified) {
@@ -479,7 +677,19 @@ void IdentityShadowThing::requestJobDetail(const String &jobId) {
 }
 
 void IdentityShadowThing::commandReply(const String &executionId, const CommandReply &payload) {
-    thingClient->commandReply(executionId, payload);
+    if (!commandCache.complete(executionId, payload)) {
+#ifdef LOG_DEBUG
+        Serial.printf("[DEBUG] Dropping late reply for executionId: %s\n", executionId.c_str());
+#endif
+        return;
+    }
+
+    // replies from executor tasks are published by loop(), never off the MQTT task
+    if (this->commandExecutor == nullptr) {
+        processCommands();
+    } else {
+        commandExecutor->release(executionId);
+    }
 }
 
 void IdentityShadowThing::jobReply(const String &jobId, const JobReply &payload) {
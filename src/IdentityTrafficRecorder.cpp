@@ -0,0 +1,98 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "IdentityTrafficRecorder.h"
+
+const uint8_t IDENTITY_TRAFFIC_MAGIC[4] = {'I', 'S', 'T', 'T'};
+const uint8_t IDENTITY_TRAFFIC_VERSION = 1;
+
+IdentityTrafficRecorder::IdentityTrafficRecorder(fs::FS &fs, const char *path): fs(fs),
+                                                                                path(path),
+                                                                                lastRecordAt(0),
+                                                                                records(0),
+                                                                                mutex(xSemaphoreCreateMutex()) {
+}
+
+bool IdentityTrafficRecorder::begin() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    file = fs.open(path, "w", true);
+    if (!file) {
+        xSemaphoreGive(mutex);
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Unable to open traffic trace: %s\n", path.c_str());
+#endif
+        return false;
+    }
+
+    file.write(IDENTITY_TRAFFIC_MAGIC, sizeof(IDENTITY_TRAFFIC_MAGIC));
+    file.write(IDENTITY_TRAFFIC_VERSION);
+
+    lastRecordAt = millis();
+    records = 0;
+
+    xSemaphoreGive(mutex);
+#ifdef LOG_INFO
+    Serial.printf("[INFO] Recording traffic to: %s\n", path.c_str());
+#endif
+    return true;
+}
+
+void IdentityTrafficRecorder::end() {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    if (file) {
+        file.flush();
+        file.close();
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Traffic trace closed, %lu records\n", records);
+#endif
+    }
+
+    xSemaphoreGive(mutex);
+}
+
+void IdentityTrafficRecorder::writeRecord(IdentityTrafficDirection direction,
+                                          const char *topic,
+                                          const uint8_t *payload,
+                                          unsigned int length) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+
+    if (!file) {
+        xSemaphoreGive(mutex);
+        return;
+    }
+
+    unsigned long now = millis();
+    uint32_t delta = now - lastRecordAt;
+    uint16_t topicLength = strlen(topic);
+    uint32_t payloadLength = length;
+    lastRecordAt = now;
+
+    file.write(static_cast<uint8_t>(direction));
+    file.write(reinterpret_cast<const uint8_t *>(&delta), sizeof(delta));
+    file.write(reinterpret_cast<const uint8_t *>(&topicLength), sizeof(topicLength));
+    file.write(reinterpret_cast<const uint8_t *>(&payloadLength), sizeof(payloadLength));
+    file.write(reinterpret_cast<const uint8_t *>(topic), topicLength);
+    file.write(payload, payloadLength);
+
+    // keep the trace usable if the device resets mid-recording
+    if (++records % 16 == 0) {
+        file.flush();
+    }
+
+    xSemaphoreGive(mutex);
+}
+
+void IdentityTrafficRecorder::recordInbound(const char *topic, const uint8_t *payload, unsigned int length) {
+    writeRecord(TRAFFIC_INBOUND, topic, payload, length);
+}
+
+void IdentityTrafficRecorder::recordOutbound(const char *topic, const uint8_t *payload, unsigned int length) {
+    writeRecord(TRAFFIC_OUTBOUND, topic, payload, length);
+}
+
+unsigned long IdentityTrafficRecorder::getRecordCount() {
+    return records;
+}
@@ -0,0 +1,218 @@
+//
+// Created by yunarta on 10/18/26.
+//
+
+#include "IdentityTrafficReplay.h"
+#include "IdentityTrafficRecorder.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+void IdentityTrafficReport::print(Print &out) {
+    out.printf("[INFO] Replay: %lu inbound, %lu outbound, %lu skipped in %lu ms (%.1f msg/s)\n",
+               inbound, outbound, skipped, durationMs, messagesPerSecond);
+    out.printf("[INFO] Callback latency us: p50 %" PRIu32 ", p90 %" PRIu32 ", p99 %" PRIu32 ", max %" PRIu32 "\n",
+               latencyP50Us, latencyP90Us, latencyP99Us, latencyMaxUs);
+    out.printf("[INFO] Heap: initial free %" PRIu32 ", peak used %" PRIu32 ", min largest free block %" PRIu32 "\n",
+               initialFreeHeap, peakHeapUsed, minLargestFreeBlock);
+    out.print(F("[INFO] Largest free block:"));
+    for (uint8_t i = 0; i < largestFreeBlockCount; i++) {
+        out.printf(" %" PRIu32, largestFreeBlock[i]);
+    }
+    out.println();
+}
+
+IdentityTrafficReplay::IdentityTrafficReplay(IdentityShadowThing *shadowThing): shadowThing(shadowThing),
+                                                                                latencyCount(0),
+                                                                                heapStride(1),
+                                                                                heapTick(0) {
+}
+
+void IdentityTrafficReplay::recordLatency(uint32_t latencyUs) {
+    // reservoir sampling keeps the percentiles representative on long traces
+    // without allocating while the heap is being measured
+    if (latencyCount < IDENTITY_TRAFFIC_LATENCY_SAMPLES) {
+        latencies[latencyCount] = latencyUs;
+    } else {
+        unsigned long slot = random(latencyCount + 1);
+        if (slot < IDENTITY_TRAFFIC_LATENCY_SAMPLES) {
+            latencies[slot] = latencyUs;
+        }
+    }
+    latencyCount++;
+}
+
+void IdentityTrafficReplay::sampleHeap(IdentityTrafficReport &report) {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    uint32_t largestBlock = ESP.getMaxAllocHeap();
+
+    if (report.initialFreeHeap > freeHeap && report.initialFreeHeap - freeHeap > report.peakHeapUsed) {
+        report.peakHeapUsed = report.initialFreeHeap - freeHeap;
+    }
+    if (largestBlock < report.minLargestFreeBlock) {
+        report.minLargestFreeBlock = largestBlock;
+    }
+
+    if (++heapTick < heapStride) {
+        return;
+    }
+    heapTick = 0;
+
+    if (report.largestFreeBlockCount == IDENTITY_TRAFFIC_HEAP_SAMPLES) {
+        // timeline is full, keep every other sample and halve the sampling rate
+        for (uint8_t i = 0; i < IDENTITY_TRAFFIC_HEAP_SAMPLES / 2; i++) {
+            report.largestFreeBlock[i] = report.largestFreeBlock[i * 2];
+        }
+        report.largestFreeBlockCount = IDENTITY_TRAFFIC_HEAP_SAMPLES / 2;
+        heapStride *= 2;
+    }
+    report.largestFreeBlock[report.largestFreeBlockCount++] = largestBlock;
+}
+
+uint32_t IdentityTrafficReplay::percentile(uint32_t *sorted, size_t count, uint8_t percent) {
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t index = (count * percent) / 100;
+    if (index >= count) {
+        index = count - 1;
+    }
+    return sorted[index];
+}
+
+bool IdentityTrafficReplay::run(fs::FS &fs, const char *path, bool realtime, IdentityTrafficReport &report) {
+    File file = fs.open(path, "r");
+    if (!file) {
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Unable to open traffic trace: %s\n", path);
+#endif
+        return false;
+    }
+
+    uint8_t magic[sizeof(IDENTITY_TRAFFIC_MAGIC)];
+    if (file.read(magic, sizeof(magic)) != sizeof(magic)
+        || memcmp(magic, IDENTITY_TRAFFIC_MAGIC, sizeof(magic)) != 0
+        || file.read() != IDENTITY_TRAFFIC_VERSION) {
+#ifdef LOG_INFO
+        Serial.printf("[INFO] Not a traffic trace: %s\n", path);
+#endif
+        file.close();
+        return false;
+    }
+
+    // allocate once up front so the replay buffers do not show up in the heap figures
+    char topic[256];
+    auto *payload = static_cast<uint8_t *>(malloc(IDENTITY_TRAFFIC_MAX_PAYLOAD + 1));
+    if (payload == nullptr) {
+        file.close();
+        return false;
+    }
+
+    // every pass starts with an empty dedupe cache, otherwise a soak run that replays the same
+    // trace only measures the cached reply path for every executionId it has seen before
+    shadowThing->commandCache.clear();
+
+    // do not record the replayed traffic into an attached trace
+    IdentityTrafficRecorder *recorder = shadowThing->trafficRecorder;
+    shadowThing->trafficRecorder = nullptr;
+
+    memset(&report, 0, sizeof(report));
+    report.initialFreeHeap = ESP.getFreeHeap();
+    report.minLargestFreeBlock = ESP.getMaxAllocHeap();
+    latencyCount = 0;
+    heapStride = 1;
+    heapTick = 0;
+
+    unsigned long startedAt = millis();
+    unsigned long pendingDelay = 0;
+    while (file.available()) {
+        int direction = file.read();
+        uint32_t delta;
+        uint16_t topicLength;
+        uint32_t payloadLength;
+        if (direction < 0
+            || file.read(reinterpret_cast<uint8_t *>(&delta), sizeof(delta)) != sizeof(delta)
+            || file.read(reinterpret_cast<uint8_t *>(&topicLength), sizeof(topicLength)) != sizeof(topicLength)
+            || file.read(reinterpret_cast<uint8_t *>(&payloadLength), sizeof(payloadLength)) != sizeof(payloadLength)) {
+            break;
+        }
+
+        pendingDelay += delta;
+        if (direction != TRAFFIC_INBOUND
+            || topicLength >= sizeof(topic)
+            || payloadLength > IDENTITY_TRAFFIC_MAX_PAYLOAD) {
+            if (direction == TRAFFIC_OUTBOUND) {
+                report.outbound++;
+            } else {
+                report.skipped++;
+            }
+            file.seek(topicLength + payloadLength, SeekCur);
+            continue;
+        }
+
+        // a trace cut off mid-record, e.g. by a reset while recording, ends here
+        if (file.read(reinterpret_cast<uint8_t *>(topic), topicLength) != topicLength
+            || file.read(payload, payloadLength) != payloadLength) {
+            report.skipped++;
+            break;
+        }
+        topic[topicLength] = '\0';
+
+        if (realtime && pendingDelay > 0) {
+            delay(pendingDelay);
+        }
+        pendingDelay = 0;
+
+        unsigned long callbackStart = micros();
+        shadowThing->mqttCallback(topic, payload, payloadLength);
+        if (shadowThing->provisioned) {
+            shadowThing->processCommands();
+        }
+        uint32_t latency = micros() - callbackStart;
+        if (latency > report.latencyMaxUs) {
+            report.latencyMaxUs = latency;
+        }
+        recordLatency(latency);
+
+        report.inbound++;
+        sampleHeap(report);
+    }
+
+    report.durationMs = millis() - startedAt;
+    file.close();
+    free(payload);
+    shadowThing->trafficRecorder = recorder;
+
+    if (report.durationMs > 0) {
+        report.messagesPerSecond = report.inbound * 1000.0f / report.durationMs;
+    }
+
+    size_t count = std::min<unsigned long>(latencyCount, IDENTITY_TRAFFIC_LATENCY_SAMPLES);
+    std::sort(latencies, latencies + count);
+    report.latencyP50Us = percentile(latencies, count, 50);
+    report.latencyP90Us = percentile(latencies, count, 90);
+    report.latencyP99Us = percentile(latencies, count, 99);
+
+    return true;
+}
+
+bool IdentityTrafficReplay::waitForCommands(unsigned long timeoutMs) {
+    IdentityCommandExecutor *executor = shadowThing->commandExecutor;
+    if (executor == nullptr || !shadowThing->provisioned) {
+        return true;
+    }
+
+    unsigned long start = millis();
+    while (!executor->isIdle()) {
+        if (millis() - start >= timeoutMs) {
+            return false;
+        }
+        shadowThing->processCommands();
+        delay(10);
+    }
+
+    // replies queued by the last tasks before they returned
+    shadowThing->processCommands();
+    return true;
+}